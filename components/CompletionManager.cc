@@ -1,6 +1,6 @@
 #include <chrono>
 #include <format>
-#include <regex>
+#include <limits>
 
 #include <magic_enum/magic_enum.hpp>
 #include <nlohmann/json.hpp>
@@ -28,9 +28,16 @@ using namespace types;
 using namespace utils;
 
 namespace {
-    const vector<string> keywords = {"class", "if", "for", "struct", "switch", "union", "while"};
-
-    bool checkNeedRetrieveCompletion(const char character) {
+    constexpr auto generateJoinTimeout = 5s;
+    constexpr auto similarSnippetCount = 4u;
+    constexpr auto similarSnippetTimeBudget = 5ms;
+
+    bool checkNeedRetrieveCompletion(const char character, const TriggerRules& triggerRules) {
+        const auto action = triggerRules.action(character);
+        if (action == TriggerRules::Action::Ignore) {
+            logger::info(format("Normal input. Ignore due to '{}'", character));
+            return false;
+        }
         const auto memoryManipulator = MemoryManipulator::GetInstance();
         const auto currentCaretPosition = memoryManipulator->getCaretPosition();
         const auto currentFileHandle = memoryManipulator->getHandle(MemoryAddress::HandleType::File);
@@ -39,50 +46,26 @@ namespace {
         if (currentLineContent.empty() || currentCaretPosition.character < currentLineContent.size()) {
             return false;
         }
-        switch (character) {
-            case ';': {
-                if (ranges::none_of(keywords, [&currentLineContent](const string& keyword) {
-                    return regex_search(currentLineContent, regex(format(R"~(\b{}\b)~", keyword)));
-                })) {
-                    logger::info("Normal input. Ignore due to ';' without any keyword");
-                    return false;
-                }
-                return true;
-            }
-            case '{': {
-                logger::info("Normal input. Ignore due to '{'");
-                return false;
-            }
-            case '}': {
-                logger::info("Normal input. Ignore due to '}'");
-                return false;
-            }
-            // TODO: Support more cases
-            default: {
-                return true;
-            }
+        if (action == TriggerRules::Action::RequireKeyword && !triggerRules.containsKeyword(currentLineContent)) {
+            logger::info(format("Normal input. Ignore due to '{}' without any keyword", character));
+            return false;
         }
-    }
-
-    bool fileTimeCompare(
-        const CompletionManager::FileTime& a,
-        const CompletionManager::FileTime& b
-    ) {
-        return a.second > b.second;
+        return true;
     }
 }
 
 CompletionManager::CompletionManager() {
-    ranges::make_heap(_recentFiles, fileTimeCompare);
-
-    _threadMonitorCurrentFilePath();
-    _threadDebounceRetrieveCompletion();
+    _scheduleMonitorCurrentFilePath();
+    _scheduleUpdateSnippetIndex();
 
     logger::info("CompletionManager is initialized");
 }
 
 CompletionManager::~CompletionManager() {
-    _isRunning = false;
+    _monitorCurrentFilePathTask.cancel();
+    _updateSnippetIndexTask.cancel();
+    unique_lock lock{_debounceRetrieveCompletionMutex};
+    _debounceRetrieveCompletionTask.cancel();
 }
 
 void CompletionManager::interactionCompletionAccept(const any&, bool& needBlockMessage) {
@@ -111,6 +94,10 @@ void CompletionManager::interactionCompletionAccept(const any&, bool& needBlockM
                 break;
             }
         }
+        _invalidateLines(
+            min(MemoryManipulator::GetInstance()->getCaretPosition().line, selection.begin.line),
+            true
+        );
         shared_lock lock(_completionsMutex);
         WebsocketManager::GetInstance()->send(CompletionAcceptClientMessage(
             _completionsOpt.value().actionId,
@@ -125,6 +112,7 @@ void CompletionManager::interactionCompletionCancel(const any& data, bool& needB
     logger::log("Cancel completion, Send CompletionCancel");
     try {
         if (any_cast<bool>(data)) {
+            _invalidateLines(MemoryManipulator::GetInstance()->getCaretPosition().line, true);
             _updateNeedRetrieveCompletion();
             WindowManager::GetInstance()->sendF13();
         }
@@ -138,6 +126,7 @@ void CompletionManager::interactionDeleteInput(const any&, bool&) {
     const auto [character, line, _] = MemoryManipulator::GetInstance()->getCaretPosition();
     try {
         if (character != 0) {
+            _invalidateLines(line);
             optional<pair<char, optional<string>>> previousCacheOpt; {
                 unique_lock lock(_completionCacheMutex);
                 previousCacheOpt = _completionCache.previous();
@@ -157,6 +146,7 @@ void CompletionManager::interactionDeleteInput(const any&, bool&) {
                 _cancelCompletion();
                 logger::log("Delete backward. Send CompletionCancel due to delete across line");
             }
+            _invalidateLines(line ? line - 1 : 0, true);
             StatisticManager::GetInstance()->removeLine(line);
         }
     } catch (const bad_any_cast& e) {
@@ -165,13 +155,42 @@ void CompletionManager::interactionDeleteInput(const any&, bool&) {
 }
 
 void CompletionManager::interactionEnterInput(const any&, bool&) {
-    // TODO: Support 1st level cache
+    const auto line = MemoryManipulator::GetInstance()->getCaretPosition().line;
+    _invalidateLines(line, true);
+    StatisticManager::GetInstance()->addLine(line);
+
+    optional<pair<uint32_t, optional<string>>> nextLineCacheOpt;
+    uint32_t candidateIndex; {
+        unique_lock lock(_completionCacheMutex);
+        nextLineCacheOpt = _completionCache.nextLine();
+        candidateIndex = _completionCache.candidateIndex();
+    }
+    if (nextLineCacheOpt.has_value()) {
+        _selectCandidate(candidateIndex);
+        if (const auto [consumedCount, completionOpt] = nextLineCacheOpt.value();
+            completionOpt.has_value()) {
+            for (uint32_t index = 0; index < consumedCount; ++index) {
+                WebsocketManager::GetInstance()->send(CompletionCacheClientMessage(false));
+            }
+            logger::log("Enter Input. Send CompletionCache due to cache hit");
+        } else {
+            {
+                unique_lock lock(_completionCacheMutex);
+                _completionCache.reset();
+            }
+            shared_lock lock(_completionsMutex);
+            WebsocketManager::GetInstance()->send(CompletionAcceptClientMessage(
+                _completionsOpt.value().actionId,
+                get<1>(_completionsOpt.value().current())
+            ));
+        }
+        return;
+    }
     if (_hasValidCache()) {
         _cancelCompletion();
-        logger::log("Enter Input. Send CompletionCancel");
+        logger::log("Enter Input. Send CompletionCancel due to cache miss");
     }
     _updateNeedRetrieveCompletion(true, '\n');
-    StatisticManager::GetInstance()->addLine(MemoryManipulator::GetInstance()->getCaretPosition().line);
 }
 
 void CompletionManager::interactionNavigateWithKey(const any&, bool&) {
@@ -207,15 +226,19 @@ void CompletionManager::interactionNormalInput(const any& data, bool&) {
     try {
         bool needRetrieveCompletion = false;
         const auto character = any_cast<char>(data);
-        optional<pair<char, optional<string>>> nextCacheOpt; {
+        _invalidateLines(MemoryManipulator::GetInstance()->getCaretPosition().line);
+        optional<pair<char, optional<string>>> nextCacheOpt;
+        uint32_t candidateIndex; {
             unique_lock lock(_completionCacheMutex);
-            nextCacheOpt = _completionCache.next();
+            nextCacheOpt = _completionCache.next(character);
+            candidateIndex = _completionCache.candidateIndex();
         }
         if (nextCacheOpt.has_value()) {
             // Has valid cache
             if (const auto [currentChar, completionOpt] = nextCacheOpt.value();
                 character == currentChar) {
                 // Cache hit
+                _selectCandidate(candidateIndex);
                 if (completionOpt.has_value()) {
                     // In cache
                     WebsocketManager::GetInstance()->send(CompletionCacheClientMessage(false));
@@ -261,6 +284,7 @@ void CompletionManager::interactionPaste(const any&, bool&) {
         const auto memoryManipulator = MemoryManipulator::GetInstance();
         const auto caretPosition = memoryManipulator->getCaretPosition();
 
+        _invalidateLines(caretPosition.line, true);
         StatisticManager::GetInstance()->addLine(
             caretPosition.line,
             caretPosition.character == 0
@@ -290,9 +314,7 @@ void CompletionManager::interactionPaste(const any&, bool&) {
                                                       ? clipboardText.back()
                                                       : clipboardText[lastNonSpaceIndex];
                     if (lastNonSpaceChar != ';') {
-                        _prolongRetrieveCompletion();
-                        _needDiscardWsAction.store(true);
-                        _needRetrieveCompletion.store(true);
+                        _updateNeedRetrieveCompletion();
                     } else {
                         _sendGenerateMessage(completionComponents);
                     }
@@ -313,7 +335,20 @@ void CompletionManager::interactionSave(const any&, bool&) {
     }
 }
 
+void CompletionManager::interactionSelectionReplace(const any& data, bool&) {
+    try {
+        const auto [startLine, _] = any_cast<pair<uint32_t, int32_t>>(data);
+        _invalidateLines(startLine, true);
+    } catch (const bad_any_cast& e) {
+        logger::log(format("Invalid interactionSelectionReplace data: {}", e.what()));
+    }
+}
+
 void CompletionManager::interactionUndo(const any&, bool&) {
+    {
+        unique_lock lock(_lineCacheMutex);
+        _lineCache.clear();
+    }
     if (_hasValidCache()) {
         _cancelCompletion();
         logger::log("Undo. Send CompletionCancel");
@@ -324,6 +359,17 @@ void CompletionManager::interactionUndo(const any&, bool&) {
 }
 
 void CompletionManager::updateCompletionConfig(const CompletionConfig& completionConfig) {
+    if (const auto contextBudgetOpt = completionConfig.contextBudget;
+        contextBudgetOpt.has_value()) {
+        const auto contextBudget = contextBudgetOpt.value();
+        logger::info(format(
+            "Update context budget: {} (prefix: {}, suffix: {})",
+            enum_name(contextBudget.unit),
+            contextBudget.prefix,
+            contextBudget.suffix
+        ));
+        _configContextBudget.store(contextBudget);
+    }
     if (const auto debounceDelayOpt = completionConfig.debounceDelay;
         debounceDelayOpt.has_value()) {
         const auto debounceDelay = debounceDelayOpt.value();
@@ -348,48 +394,81 @@ void CompletionManager::updateCompletionConfig(const CompletionConfig& completio
         logger::info(format("Update recent file count: {}", recentFileCount));
         _configRecentFileCount.store(recentFileCount);
     }
+    if (const auto refreshCachedCompletionOpt = completionConfig.refreshCachedCompletion;
+        refreshCachedCompletionOpt.has_value()) {
+        const auto refreshCachedCompletion = refreshCachedCompletionOpt.value();
+        logger::info(format("Update refresh cached completion: {}", refreshCachedCompletion));
+        _configRefreshCachedCompletion.store(refreshCachedCompletion);
+    }
     if (const auto suffixLineCountOpt = completionConfig.suffixLineCount;
         suffixLineCountOpt.has_value()) {
         const auto suffixLineCount = suffixLineCountOpt.value();
         logger::info(format("Update suffix line count: {}", suffixLineCount));
         _configSuffixLineCount.store(suffixLineCount);
     }
+    if (const auto triggerRulesOpt = completionConfig.triggerRules;
+        triggerRulesOpt.has_value()) {
+        const auto& triggerRules = triggerRulesOpt.value();
+        logger::info(format("Update trigger rules with {} keywords", triggerRules.keywords().size()));
+        _configTriggerRules.store(make_shared<const TriggerRules>(triggerRules));
+    }
 }
 
 void CompletionManager::wsCompletionGenerate(nlohmann::json&& data) {
-    if (const auto serverMessage = CompletionGenerateServerMessage(move(data));
-        serverMessage.result == "success") {
+    const auto serverMessage = CompletionGenerateServerMessage(move(data));
+    const auto fingerprintOpt = serverMessage.fingerprint();
+    bool isStale; {
+        unique_lock lock(_generateMutex);
+        isStale = fingerprintOpt.has_value() && fingerprintOpt.value() != _generateFingerprint;
+        if (!isStale) {
+            _generateTimeOpt.reset();
+        }
+    }
+    if (serverMessage.result == "success") {
         const auto completions = serverMessage.completions().value();
         if (completions.empty()) {
             logger::log("(WsAction::CompletionGenerate) Ignore due to empty completions");
             return;
         }
+        if (fingerprintOpt.has_value()) {
+            unique_lock lock(_recentCompletionsMutex);
+            _recentCompletions.put(fingerprintOpt.value(), make_shared<const Completions>(completions));
+        }
         const auto& actionId = completions.actionId;
+        if (isStale) {
+            logger::log("(WsAction::CompletionGenerate) Ignore due to stale fingerprint");
+            WebsocketManager::GetInstance()->send(CompletionCancelClientMessage(actionId, false));
+            return;
+        }
         if (_needDiscardWsAction.load()) {
             logger::log("(WsAction::CompletionGenerate) Ignore due to debounce");
             WebsocketManager::GetInstance()->send(CompletionCancelClientMessage(actionId, false));
             return;
         }
-        const auto [candidate, index] = completions.current(); {
-            unique_lock lock(_completionsMutex);
-            _completionsOpt.emplace(completions);
-        } {
-            unique_lock lock(_completionCacheMutex);
-            _completionCache.reset(iconv::autoEncode(candidate));
+        _showCompletions(completions);
+    } else if (serverMessage.result == "contextMismatch") {
+        {
+            unique_lock lock(_contextDeltaMutex);
+            _contextDelta.reset();
+        }
+        if (isStale) {
+            logger::log("(WsAction::CompletionGenerate) Ignore context mismatch due to stale fingerprint");
+            return;
+        }
+        if (_needDiscardWsAction.load()) {
+            logger::log("(WsAction::CompletionGenerate) Ignore context mismatch due to debounce");
+            return;
+        }
+        optional<CompletionComponents> completionComponentsOpt; {
+            shared_lock lock(_lastCompletionComponentsMutex);
+            if (_lastCompletionComponents.has_value()) {
+                completionComponentsOpt.emplace(_lastCompletionComponents.value());
+            }
+        }
+        if (completionComponentsOpt.has_value()) {
+            logger::info("(WsAction::CompletionGenerate) Resend full context due to context mismatch");
+            _sendGenerateMessage(completionComponentsOpt.value());
         }
-
-        StatisticManager::GetInstance()->setEditedCompletion(actionId, completions.selection.begin.line, candidate);
-
-        const auto interactionLock = InteractionMonitor::GetInstance()->getInteractionLock();
-        const auto [height, xPosition,yPosition] = common::getCaretDimensions();
-        WebsocketManager::GetInstance()->send(CompletionSelectClientMessage(
-            completions.actionId,
-            completions.generateType,
-            index,
-            height,
-            xPosition,
-            yPosition
-        ));
     } else {
         logger::warn(format(
             "(WsAction::CompletionGenerate) Result: {}\n"
@@ -420,7 +499,49 @@ bool CompletionManager::_cancelCompletion() {
     return hasCompletion;
 }
 
+void CompletionManager::_selectCandidate(const uint32_t index) {
+    string actionId, candidate;
+    CompletionComponents::GenerateType generateType;
+    uint32_t line; {
+        unique_lock lock(_completionsMutex);
+        if (!_completionsOpt.has_value() || get<1>(_completionsOpt.value().current()) == index) {
+            return;
+        }
+        auto& completions = _completionsOpt.value();
+        candidate = get<0>(completions.select(index));
+        actionId = completions.actionId;
+        generateType = completions.generateType;
+        line = completions.selection.begin.line;
+    }
+
+    StatisticManager::GetInstance()->setEditedCompletion(actionId, line, candidate);
+
+    const auto [height, xPosition, yPosition] = common::getCaretDimensions(false);
+    WebsocketManager::GetInstance()->send(CompletionSelectClientMessage(
+        actionId,
+        generateType,
+        index,
+        height,
+        xPosition,
+        yPosition
+    ));
+    logger::log(format("Switch to candidate {} locally", index));
+}
+
 void CompletionManager::_sendGenerateMessage(const CompletionComponents& completionComponents) {
+    const auto fingerprint = completionComponents.fingerprint();
+    const auto currentTime = chrono::high_resolution_clock::now(); {
+        unique_lock lock(_generateMutex);
+        if (_generateTimeOpt.has_value() && _generateFingerprint == fingerprint &&
+            currentTime - _generateTimeOpt.value() < generateJoinTimeout) {
+            _needDiscardWsAction.store(false);
+            logger::log("Join in-flight completion request with identical context");
+            return;
+        }
+        _generateFingerprint = fingerprint;
+        _generateTimeOpt.emplace(currentTime);
+    }
+
     auto currentPath = completionComponents.path;
     bool isSameFilePath; {
         shared_lock lock(_lastEditedFilePathMutex);
@@ -433,13 +554,27 @@ void CompletionManager::_sendGenerateMessage(const CompletionComponents& complet
     }
 
     _needDiscardWsAction.store(false);
-    WebsocketManager::GetInstance()->send(CompletionGenerateClientMessage(completionComponents));
+    const auto websocketManager = WebsocketManager::GetInstance();
+    if (websocketManager->hasCapability(WsCapability::DeltaContext)) {
+        unique_lock lock(_contextDeltaMutex);
+        websocketManager->send(CompletionGenerateClientMessage(
+            completionComponents,
+            _contextDelta.update(
+                websocketManager->sessionId(),
+                completionComponents.path,
+                completionComponents.getPrefix(),
+                completionComponents.getSuffix()
+            )
+        ));
+    } else {
+        websocketManager->send(CompletionGenerateClientMessage(completionComponents));
+    }
     logger::info("Generate 'common' completion");
 }
 
 vector<filesystem::path> CompletionManager::_getRecentFiles() const {
     shared_lock lock(_recentFilesMutex);
-    return _recentFiles | views::keys | ranges::to<vector>();
+    return _recentFiles | ranges::to<vector>();
 }
 
 optional<CompletionComponents> CompletionManager::_retrieveCompletionComponents(
@@ -459,37 +594,100 @@ optional<CompletionComponents> CompletionManager::_retrieveCompletionComponents(
             return nullopt;
         }
 
-        completionComponentsOpt.emplace(generateType, caretPosition, currentPath); {
-            const auto currentLine = memoryManipulator->getLineContent(
-                currentFileHandle, caretPosition.line
-            );
-            prefix = iconv::autoDecode(currentLine.substr(0, caretPosition.character));
+        completionComponentsOpt.emplace(generateType, caretPosition, currentPath);
+
+        const auto contextBudget = _configContextBudget.load();
+        const auto isLineBudget = contextBudget.unit == ContextBudget::Unit::Line;
+        const auto measure = [&contextBudget](const string_view content) -> uint64_t {
+            switch (contextBudget.unit) {
+                case ContextBudget::Unit::Byte: {
+                    return content.size() + 1;
+                }
+                case ContextBudget::Unit::Token: {
+                    return common::estimateTokens(content) + 1;
+                }
+                default: {
+                    return 0;
+                }
+            }
+        };
+        const auto prefixLineCount = isLineBudget
+                                         ? min(caretPosition.line, _configPrefixLineCount.load())
+                                         : caretPosition.line;
+        const auto suffixLineCount = isLineBudget
+                                         ? _configSuffixLineCount.load()
+                                         : currentLineCount - min(caretPosition.line, currentLineCount);
+        auto prefixBudget = isLineBudget ? numeric_limits<uint64_t>::max() : contextBudget.prefix;
+        auto suffixBudget = isLineBudget ? numeric_limits<uint64_t>::max() : contextBudget.suffix;
+        vector<string> prefixLines, suffixLines;
+        prefixLines.reserve(min(prefixLineCount, 1024u));
+        suffixLines.reserve(min(suffixLineCount, 1024u));
+        string currentPrefix; {
+            unique_lock lock(_lineCacheMutex);
+            _lineCache.validate(currentFileHandle, currentLineCount);
+            const auto getLine = [&](const uint32_t line) {
+                if (auto lineOpt = _lineCache.get(line); lineOpt.has_value()) {
+                    return move(lineOpt.value());
+                }
+                auto decodedLine = iconv::autoDecode(memoryManipulator->getLineContent(currentFileHandle, line));
+                _lineCache.put(line, decodedLine);
+                return decodedLine;
+            };
+
+            const auto currentLine = memoryManipulator->getLineContent(currentFileHandle, caretPosition.line);
+            currentPrefix = iconv::autoDecode(currentLine.substr(0, caretPosition.character));
             suffix = iconv::autoDecode(currentLine.substr(caretPosition.character));
+            prefixBudget -= min(prefixBudget, measure(currentPrefix));
+            suffixBudget -= min(suffixBudget, measure(suffix));
+            for (uint32_t index = 1; index <= prefixLineCount; ++index) {
+                auto line = getLine(caretPosition.line - index);
+                if (const auto cost = measure(line); cost <= prefixBudget) {
+                    prefixBudget -= cost;
+                } else {
+                    break;
+                }
+                prefixLines.push_back(move(line));
+            }
+            for (uint32_t index = 1; index < suffixLineCount; ++index) {
+                auto line = getLine(caretPosition.line + index);
+                if (const auto cost = measure(line); cost <= suffixBudget) {
+                    suffixBudget -= cost;
+                } else {
+                    break;
+                }
+                suffixLines.push_back(move(line));
+            }
         }
-        for (
-            uint32_t index = 1;
-            index <= min(caretPosition.line, _configPrefixLineCount.load());
-            ++index
-        ) {
-            const auto tempLine = iconv::autoDecode(memoryManipulator->getLineContent(
-                currentFileHandle, caretPosition.line - index
-            )).append("\n");
-            prefix.insert(0, tempLine);
-            if (prefixForSymbol.empty() && regex_search(tempLine, regex(R"~(^\/\/.*|^\/\*\*.*)~"))) {
-                prefixForSymbol = prefix;
+
+        const auto joinPrefix = [&](const size_t lineCount) {
+            size_t length = currentPrefix.size();
+            for (size_t index = 0; index < lineCount; ++index) {
+                length += prefixLines[index].size() + 1;
+            }
+            string result;
+            result.reserve(length);
+            for (size_t index = lineCount; index > 0; --index) {
+                result.append(prefixLines[index - 1]).append("\n");
             }
+            return result.append(currentPrefix);
+        };
+        prefix = joinPrefix(prefixLines.size());
+        if (const auto commentIterator = ranges::find_if(prefixLines, [](const string& line) {
+            return line.starts_with("//") || line.starts_with("/**");
+        }); commentIterator != prefixLines.end()) {
+            prefixForSymbol = joinPrefix(distance(prefixLines.begin(), commentIterator) + 1);
         }
-        for (uint32_t index = 1; index < _configSuffixLineCount.load(); ++index) {
-            const auto tempLine = iconv::autoDecode(
-                memoryManipulator->getLineContent(currentFileHandle, caretPosition.line + index)
-            );
-            suffix.append("\n").append(tempLine);
+        for (const auto& suffixLine: suffixLines) {
+            suffix.append("\n").append(suffixLine);
         }
     }
     if (completionComponentsOpt.has_value()) {
         auto& completionComponents = completionComponentsOpt.value();
         completionComponents.setContext(prefix, infix, suffix);
         completionComponents.setRecentFiles(_getRecentFiles());
+        completionComponents.setSimilarSnippets(
+            _snippetIndex.query(prefix, currentPath, similarSnippetCount, similarSnippetTimeBudget)
+        );
         completionComponents.setSymbols(
             SymbolManager::GetInstance()->getSymbols(prefixForSymbol, currentPath)
         );
@@ -498,6 +696,76 @@ optional<CompletionComponents> CompletionManager::_retrieveCompletionComponents(
     return completionComponentsOpt;
 }
 
+void CompletionManager::_invalidateLines(const uint32_t line, const bool isShifted) {
+    unique_lock lock(_lineCacheMutex);
+    if (isShifted) {
+        _lineCache.invalidateFrom(line);
+    } else {
+        _lineCache.invalidate(line);
+    }
+}
+
+bool CompletionManager::_reuseCompletions(const CompletionComponents& completionComponents) {
+    const auto websocketManager = WebsocketManager::GetInstance();
+    if (!websocketManager->hasCapability(WsCapability::CompletionReuse)) {
+        return false;
+    }
+    shared_ptr<const Completions> cachedCompletions; {
+        unique_lock lock(_recentCompletionsMutex);
+        if (const auto completionsOpt = _recentCompletions.get(completionComponents.fingerprint());
+            completionsOpt.has_value()) {
+            cachedCompletions = completionsOpt.value();
+        }
+    }
+    if (!cachedCompletions) {
+        return false;
+    }
+    const Completions completions(
+        common::uuid(),
+        cachedCompletions->generateType,
+        cachedCompletions->selection,
+        cachedCompletions->candidates()
+    );
+    logger::info(format(
+        "Reuse completion '{}' as '{}' for an identical context",
+        cachedCompletions->actionId,
+        completions.actionId
+    ));
+    _needDiscardWsAction.store(false);
+    websocketManager->send(CompletionReuseClientMessage(completions.actionId, cachedCompletions->actionId));
+    _showCompletions(completions);
+    return true;
+}
+
+void CompletionManager::_showCompletions(const Completions& completions) {
+    const auto& actionId = completions.actionId;
+    const auto [candidate, index] = completions.current(); {
+        unique_lock lock(_completionsMutex);
+        _completionsOpt.emplace(completions);
+    } {
+        vector<string> encodedCandidates;
+        encodedCandidates.reserve(completions.candidates().size());
+        for (const auto& completionCandidate: completions.candidates()) {
+            encodedCandidates.push_back(iconv::autoEncode(completionCandidate));
+        }
+        unique_lock lock(_completionCacheMutex);
+        _completionCache.reset(encodedCandidates, index);
+    }
+
+    StatisticManager::GetInstance()->setEditedCompletion(actionId, completions.selection.begin.line, candidate);
+
+    const auto interactionLock = InteractionMonitor::GetInstance()->getInteractionLock();
+    const auto [height, xPosition,yPosition] = common::getCaretDimensions();
+    WebsocketManager::GetInstance()->send(CompletionSelectClientMessage(
+        actionId,
+        completions.generateType,
+        index,
+        height,
+        xPosition,
+        yPosition
+    ));
+}
+
 bool CompletionManager::_hasValidCache() const {
     bool hasValidCache; {
         shared_lock lock(_completionCacheMutex);
@@ -506,20 +774,77 @@ bool CompletionManager::_hasValidCache() const {
     return hasValidCache;
 }
 
-void CompletionManager::_prolongRetrieveCompletion() {
-    _debounceRetrieveCompletionTime.store(chrono::high_resolution_clock::now());
-}
-
 void CompletionManager::_updateNeedRetrieveCompletion(const bool need, const char character) {
-    _prolongRetrieveCompletion();
+    const auto needRetrieveCompletion =
+            need && (!character || checkNeedRetrieveCompletion(character, *_configTriggerRules.load()));
     _needDiscardWsAction.store(true);
-    _needRetrieveCompletion.store(need && (!character || checkNeedRetrieveCompletion(character)));
+    unique_lock lock{_debounceRetrieveCompletionMutex};
+    _debounceRetrieveCompletionTask.cancel();
+    if (needRetrieveCompletion) {
+        const auto debounceDelay = _configDebounceDelay.load();
+        _debounceRetrieveCompletionTask = TaskScheduler::GetInstance()->schedule(
+            debounceDelay,
+            [this, deadline = chrono::high_resolution_clock::now() + debounceDelay] {
+                _retrieveCompletion(deadline);
+            }
+        );
+    }
 }
 
-void CompletionManager::_threadMonitorCurrentFilePath() {
-    thread([this] {
-        uint32_t recentFilesCounter = 0;
-        while (_isRunning) {
+void CompletionManager::_retrieveCompletion(const Time deadline) {
+    const auto firedTime = chrono::high_resolution_clock::now();
+    try {
+        const auto memoryManipulator = MemoryManipulator::GetInstance();
+        const auto caretPosition = memoryManipulator->getCaretPosition();
+        bool needCache; {
+            shared_lock lock(_lastCompletionComponentsMutex);
+            needCache = _lastCompletionComponents.has_value() && _lastCompletionComponents.value().
+                        needCache(caretPosition);
+        }
+        optional<CompletionComponents> completionComponentsOpt;
+        if (needCache) {
+            const auto interactionLock = InteractionMonitor::GetInstance()->getInteractionLock();
+            if (const auto fileHandle = memoryManipulator->getHandle(MemoryAddress::HandleType::File)) {
+                {
+                    shared_lock lock(_lastCompletionComponentsMutex);
+                    completionComponentsOpt.emplace(_lastCompletionComponents.value());
+                }
+                completionComponentsOpt.value().updateCaretPosition(caretPosition);
+                const auto currentLine = memoryManipulator->getLineContent(fileHandle, caretPosition.line);
+                completionComponentsOpt.value().useCachedContext(
+                    iconv::autoDecode(currentLine.substr(0, caretPosition.character)),
+                    "",
+                    iconv::autoDecode(currentLine.substr(caretPosition.character))
+                );
+            }
+        } else if (auto retrievedComponentsOpt = _retrieveCompletionComponents(
+            caretPosition,
+            CompletionComponents::GenerateType::Common
+        ); retrievedComponentsOpt.has_value()) {
+            completionComponentsOpt.emplace(move(retrievedComponentsOpt.value()));
+        }
+        if (completionComponentsOpt.has_value()) {
+            const auto& completionComponents = completionComponentsOpt.value();
+            if (!_reuseCompletions(completionComponents) || _configRefreshCachedCompletion.load()) {
+                _sendGenerateMessage(completionComponents);
+            }
+            unique_lock lock(_lastCompletionComponentsMutex);
+            _lastCompletionComponents.emplace(completionComponents);
+        }
+    } catch (const exception& e) {
+        logger::warn(format("(_retrieveCompletion) Exception: {}", e.what()));
+    }
+    logger::debug(format(
+        "Debounce fired {}us after deadline, request built in {}us",
+        chrono::duration_cast<chrono::microseconds>(firedTime - deadline).count(),
+        chrono::duration_cast<chrono::microseconds>(chrono::high_resolution_clock::now() - firedTime).count()
+    ));
+}
+
+void CompletionManager::_scheduleMonitorCurrentFilePath() {
+    _monitorCurrentFilePathTask = TaskScheduler::GetInstance()->scheduleEvery(
+        200ms,
+        [this, recentFilesCounter = uint32_t{0}]() mutable {
             filesystem::path currentPath; {
                 const auto interactionLock = InteractionMonitor::GetInstance()->getInteractionLock();
                 currentPath = MemoryManipulator::GetInstance()->getCurrentFilePath().lexically_normal();
@@ -539,71 +864,44 @@ void CompletionManager::_threadMonitorCurrentFilePath() {
                 recentFilesCounter = 0;
                 if (const auto extension = currentPath.extension();
                     extension == ".c" || extension == ".h") {
-                    unique_lock lock(_recentFilesMutex);
-                    _recentFiles.emplace_back(currentPath, chrono::high_resolution_clock::now());
-                    ranges::push_heap(_recentFiles, fileTimeCompare);
-                    if (_recentFiles.size() > _configRecentFileCount.load()) {
-                        ranges::pop_heap(_recentFiles, fileTimeCompare);
-                        _recentFiles.pop_front();
-                    }
+                    _touchRecentFile(currentPath);
                 }
             }
             recentFilesCounter++;
-            this_thread::sleep_for(200ms);
         }
-    }).detach();
+    );
 }
 
-void CompletionManager::_threadDebounceRetrieveCompletion() {
-    thread([this] {
-        while (_isRunning) {
-            if (const auto pastTime = chrono::high_resolution_clock::now() - _debounceRetrieveCompletionTime.load();
-                pastTime >= chrono::milliseconds(_configDebounceDelay.load()) && _needRetrieveCompletion.load()) {
+void CompletionManager::_scheduleUpdateSnippetIndex() {
+    _updateSnippetIndexTask = TaskScheduler::GetInstance()->scheduleEvery(
+        2s,
+        [this] {
+            if (_isUpdatingSnippetIndex.exchange(true)) {
+                return;
+            }
+            _snippetIndexPool.submit([this] {
                 try {
-                    const auto memoryManipulator = MemoryManipulator::GetInstance();
-                    const auto caretPosition = memoryManipulator->getCaretPosition();
-                    bool needCache; {
-                        shared_lock lock(_lastCompletionComponentsMutex);
-                        needCache = _lastCompletionComponents.has_value() && _lastCompletionComponents.value().
-                                    needCache(caretPosition);
-                    }
-                    if (needCache) {
-                        const auto interactionLock = InteractionMonitor::GetInstance()->getInteractionLock();
-                        if (const auto fileHandle = memoryManipulator->getHandle(MemoryAddress::HandleType::File)) {
-                            optional<CompletionComponents> completionComponentsOpt; {
-                                shared_lock lock(_lastCompletionComponentsMutex);
-                                completionComponentsOpt.emplace(_lastCompletionComponents.value());
-                            }
-                            completionComponentsOpt.value().updateCaretPosition(caretPosition);
-                            const auto currentLine = memoryManipulator->getLineContent(fileHandle, caretPosition.line);
-                            completionComponentsOpt.value().useCachedContext(
-                                iconv::autoDecode(currentLine.substr(0, caretPosition.character)),
-                                "",
-                                iconv::autoDecode(currentLine.substr(caretPosition.character))
-                            );
-                            _sendGenerateMessage(completionComponentsOpt.value()); {
-                                unique_lock lock(_lastCompletionComponentsMutex);
-                                _lastCompletionComponents.emplace(completionComponentsOpt.value());
-                            }
-                        }
-                    } else {
-                        if (const auto completionComponentsOpt = _retrieveCompletionComponents(
-                            caretPosition,
-                            CompletionComponents::GenerateType::Common
-                        ); completionComponentsOpt.has_value()) {
-                            _sendGenerateMessage(completionComponentsOpt.value());
-                            logger::info("Generate common completion"); {
-                                unique_lock lock(_lastCompletionComponentsMutex);
-                                _lastCompletionComponents.emplace(completionComponentsOpt.value());
-                            }
-                        }
+                    const auto recentFiles = _getRecentFiles();
+                    _snippetIndex.retain(recentFiles);
+                    for (const auto& recentFile: recentFiles) {
+                        _snippetIndex.update(recentFile);
                     }
                 } catch (const exception& e) {
-                    logger::warn(format("(_threadDebounceRetrieveCompletion) Exception: {}", e.what()));
+                    logger::warn(format("(_scheduleUpdateSnippetIndex) Exception: {}", e.what()));
                 }
-                _needRetrieveCompletion.store(false);
-            }
-            this_thread::sleep_for(10ms);
+                _isUpdatingSnippetIndex.store(false);
+            });
         }
-    }).detach();
+    );
+}
+
+void CompletionManager::_touchRecentFile(const filesystem::path& path) {
+    unique_lock lock(_recentFilesMutex);
+    if (const auto iterator = ranges::find(_recentFiles, path); iterator != _recentFiles.end()) {
+        _recentFiles.erase(iterator);
+    }
+    _recentFiles.push_front(path);
+    while (_recentFiles.size() > _configRecentFileCount.load()) {
+        _recentFiles.pop_back();
+    }
 }
@@ -5,18 +5,23 @@
 
 #include <singleton_dclp.hpp>
 
+#include <components/TaskScheduler.h>
 #include <models/SymbolInfo.h>
 #include <types/CaretPosition.h>
 #include <types/common.h>
 #include <types/Completions.h>
 #include <types/CompletionCache.h>
+#include <types/ContextDelta.h>
 #include <types/EditedCompletion.h>
+#include <types/LineCache.h>
+#include <types/LruCache.h>
+#include <types/SnippetIndex.h>
+#include <types/TriggerRules.h>
+#include <types/WorkStealingPool.h>
 
 namespace components {
     class CompletionManager : public SingletonDclp<CompletionManager> {
     public:
-        using FileTime = std::pair<std::filesystem::path, std::chrono::high_resolution_clock::time_point>;
-
         CompletionManager();
 
         ~CompletionManager() override;
@@ -39,6 +44,8 @@ namespace components {
 
         void interactionSave(const std::any&, bool&);
 
+        void interactionSelectionReplace(const std::any& data, bool&);
+
         void interactionUndo(const std::any&, bool&);
 
         void updateCompletionConfig(const models::CompletionConfig& completionConfig);
@@ -48,39 +55,60 @@ namespace components {
     private:
         mutable std::shared_mutex _completionsMutex, _completionCacheMutex, _currentFilePathMutex,
                 _lastCaretPositionMutex, _lastCompletionComponentsMutex, _lastEditedFilePathMutex, _recentFilesMutex;
+        mutable std::mutex _contextDeltaMutex, _debounceRetrieveCompletionMutex, _generateMutex, _lineCacheMutex, _recentCompletionsMutex;
         types::CaretPosition _lastCaretPosition{};
-        std::atomic<bool> _isRunning{true}, _needDiscardWsAction{false},
-                _needRetrieveCompletion{false};
+        std::atomic<bool> _configRefreshCachedCompletion{false}, _isUpdatingSnippetIndex{false}, _needDiscardWsAction{false};
         std::atomic<std::chrono::milliseconds> _configDebounceDelay{std::chrono::milliseconds(50)};
-        std::atomic<types::Time> _debounceRetrieveCompletionTime;
+        std::atomic<types::ContextBudget> _configContextBudget{{types::ContextBudget::Unit::Line, 0, 0}};
+        std::atomic<std::shared_ptr<const types::TriggerRules>> _configTriggerRules{
+            std::make_shared<const types::TriggerRules>()
+        };
         std::atomic<uint32_t> _configPasteFixMaxTriggerLineCount{10}, _configPrefixLineCount{200},
                 _configRecentFileCount{5}, _configSuffixLineCount{80};
-        std::deque<FileTime> _recentFiles;
+        std::deque<std::filesystem::path> _recentFiles;
         std::filesystem::path _currentFilePath, _lastEditedFilePath;
         std::optional<types::CompletionComponents> _lastCompletionComponents;
         std::optional<types::Completions> _completionsOpt;
+        std::optional<types::Time> _generateTimeOpt;
+        uint64_t _generateFingerprint{};
         types::CompletionCache _completionCache;
+        types::ContextDelta _contextDelta;
+        types::LruCache<uint64_t, std::shared_ptr<const types::Completions>> _recentCompletions{64};
+        TaskScheduler::Handle _debounceRetrieveCompletionTask, _monitorCurrentFilePathTask, _updateSnippetIndexTask;
+        mutable types::LineCache _lineCache;
+        types::SnippetIndex _snippetIndex;
+        const types::WorkStealingPool _snippetIndexPool{1};
 
         bool _cancelCompletion();
 
         std::vector<std::filesystem::path> _getRecentFiles() const;
 
+        void _invalidateLines(uint32_t line, bool isShifted = false);
+
         std::optional<types::CompletionComponents> _retrieveCompletionComponents(
             const types::CaretPosition& caretPosition,
             types::CompletionComponents::GenerateType generateType,
             const std::string& infix = ""
         ) const;
 
+        bool _reuseCompletions(const types::CompletionComponents& completionComponents);
+
+        void _selectCandidate(uint32_t index);
+
+        void _showCompletions(const types::Completions& completions);
+
         void _sendGenerateMessage(const types::CompletionComponents& completionComponents);
 
         bool _hasValidCache() const;
 
-        void _prolongRetrieveCompletion();
-
         void _updateNeedRetrieveCompletion(bool need = true, char character = 0);
 
-        void _threadMonitorCurrentFilePath();
+        void _retrieveCompletion(types::Time deadline);
+
+        void _scheduleMonitorCurrentFilePath();
+
+        void _scheduleUpdateSnippetIndex();
 
-        void _threadDebounceRetrieveCompletion();
+        void _touchRecentFile(const std::filesystem::path& path);
     };
 }
@@ -32,13 +32,13 @@ ConfigManager::ConfigManager() {
         _siVersionString = "_4.00." + format("{:0>{}}", build, 4);
     }
 
-    _threadMonitorCurrentProjectPath();
+    _scheduleMonitorCurrentProjectPath();
 
     logger::info(format("Configurator is initialized with version: {}", _siVersionString));
 }
 
 ConfigManager::~ConfigManager() {
-    _isRunning = false;
+    _monitorCurrentProjectPathTask.cancel();
 }
 
 SiVersion::Full ConfigManager::version() const {
@@ -50,21 +50,18 @@ string ConfigManager::reportVersion() const {
 }
 
 
-void ConfigManager::_threadMonitorCurrentProjectPath() {
-    thread([this] {
-        while (_isRunning) {
-            // TODO: Check if need InteractionMonitor::GetInstance()->getInteractionLock();
-            const auto currentProject = MemoryManipulator::GetInstance()->getProjectDirectory();
-            bool isSameProject; {
-                shared_lock lock(_currentProjectPathMutex);
-                isSameProject = currentProject == _currentProjectPath;
-            }
-            if (!isSameProject) {
-                WebsocketManager::GetInstance()->send(EditorSwitchProjectClientMessage(currentProject));
-                unique_lock lock(_currentProjectPathMutex);
-                _currentProjectPath = currentProject;
-            }
-            this_thread::sleep_for(1s);
+void ConfigManager::_scheduleMonitorCurrentProjectPath() {
+    _monitorCurrentProjectPathTask = TaskScheduler::GetInstance()->scheduleEvery(1s, [this] {
+        // TODO: Check if need InteractionMonitor::GetInstance()->getInteractionLock();
+        const auto currentProject = MemoryManipulator::GetInstance()->getProjectDirectory();
+        bool isSameProject; {
+            shared_lock lock(_currentProjectPathMutex);
+            isSameProject = currentProject == _currentProjectPath;
         }
-    }).detach();
+        if (!isSameProject) {
+            WebsocketManager::GetInstance()->send(EditorSwitchProjectClientMessage(currentProject));
+            unique_lock lock(_currentProjectPathMutex);
+            _currentProjectPath = currentProject;
+        }
+    });
 }
@@ -5,6 +5,7 @@
 
 #include <singleton_dclp.hpp>
 
+#include <components/TaskScheduler.h>
 #include <models/configs.h>
 #include <types/SiVersion.h>
 
@@ -24,11 +25,11 @@ namespace components {
 
     private:
         mutable std::shared_mutex _currentProjectPathMutex;
-        std::atomic<bool> _isRunning{true};
         std::filesystem::path _currentProjectPath;
         std::string _siVersionString;
         types::SiVersion::Full _siVersion;
+        TaskScheduler::Handle _monitorCurrentProjectPathTask;
 
-        void _threadMonitorCurrentProjectPath();
+        void _scheduleMonitorCurrentProjectPath();
     };
 }
@@ -138,15 +138,16 @@ InteractionMonitor::InteractionMonitor()
         abort();
     }
 
-    _threadAutoSave();
-    _threadMonitorCaretPosition();
-    _threadReleaseInteractionLock();
+    _scheduleAutoSave();
+    _scheduleMonitorCaretPosition();
 
     logger::info("InteractionMonitor is initialized.");
 }
 
 InteractionMonitor::~InteractionMonitor() {
-    _isRunning.store(false);
+    _autoSaveTask.cancel();
+    _monitorCaretPositionTask.cancel();
+    _releaseInteractionLockTask.cancel();
     _interactionMutex.unlock();
 }
 
@@ -308,6 +309,7 @@ void InteractionMonitor::_interactionLockShared() {
         _interactionMutex.lock_shared();
         _needUnlockInteraction = true;
         _interactionUnlockTime.store(chrono::high_resolution_clock::now());
+        _scheduleReleaseInteractionLock(_configInteractionUnlockDelay.load());
     }
 }
 
@@ -522,60 +524,54 @@ void InteractionMonitor::_processWindowMessage(const long lParam) {
     }
 }
 
-void InteractionMonitor::_threadAutoSave() const {
-    thread([this] {
-        Time lastSaveTime = chrono::high_resolution_clock::now();
-        while (_isRunning.load()) {
+void InteractionMonitor::_scheduleAutoSave() {
+    _autoSaveTask = TaskScheduler::GetInstance()->scheduleEvery(
+        1s,
+        [this, lastSaveTime = chrono::high_resolution_clock::now()]() mutable {
             if (const auto autoSaveInterval = chrono::seconds(_configAutoSaveInterval.load());
                 chrono::high_resolution_clock::now() - lastSaveTime > autoSaveInterval) {
                 WindowManager::GetInstance()->sendSave();
                 lastSaveTime = chrono::high_resolution_clock::now();
             }
-            this_thread::sleep_for(1s);
         }
-    }).detach();
+    );
 }
 
-void InteractionMonitor::_threadMonitorCaretPosition() {
-    thread([this] {
-        while (_isRunning.load()) {
-            if (const auto navigationBuffer = _navigateKeycode.load()) {
-                ignore = _handleInteraction(Interaction::NavigateWithKey, navigationBuffer);
-                _navigateKeycode.store(0);
-                continue;
-            }
+void InteractionMonitor::_scheduleMonitorCaretPosition() {
+    _monitorCaretPositionTask = TaskScheduler::GetInstance()->scheduleEvery(100ms, [this] {
+        if (const auto navigationBuffer = _navigateKeycode.exchange(0)) {
+            ignore = _handleInteraction(Interaction::NavigateWithKey, navigationBuffer);
+        }
 
-            // TODO: Check if need InteractionMonitor::GetInstance()->getInteractionLock();
-            auto newCursorPosition = MemoryManipulator::GetInstance()->getCaretPosition();
-            newCursorPosition.maxCharacter = newCursorPosition.character;
-            if (const auto oldCursorPosition = _currentCaretPosition.load();
-                oldCursorPosition != newCursorPosition) {
-                _currentCaretPosition.store(newCursorPosition);
-                if (const auto navigateWithMouseOpt = _navigateWithMouse.load();
-                    navigateWithMouseOpt.has_value()) {
-                    _handleInteraction(
-                        Interaction::NavigateWithMouse,
-                        make_tuple(newCursorPosition, oldCursorPosition)
-                    );
-                    _navigateWithMouse.store(nullopt);
-                }
+        // TODO: Check if need InteractionMonitor::GetInstance()->getInteractionLock();
+        auto newCursorPosition = MemoryManipulator::GetInstance()->getCaretPosition();
+        newCursorPosition.maxCharacter = newCursorPosition.character;
+        if (const auto oldCursorPosition = _currentCaretPosition.load();
+            oldCursorPosition != newCursorPosition) {
+            _currentCaretPosition.store(newCursorPosition);
+            if (const auto navigateWithMouseOpt = _navigateWithMouse.load();
+                navigateWithMouseOpt.has_value()) {
+                _handleInteraction(
+                    Interaction::NavigateWithMouse,
+                    make_tuple(newCursorPosition, oldCursorPosition)
+                );
+                _navigateWithMouse.store(nullopt);
             }
-            this_thread::sleep_for(100ms);
         }
-    }).detach();
+    });
 }
 
-void InteractionMonitor::_threadReleaseInteractionLock() {
-    thread([this] {
-        while (_isRunning.load()) {
-            if (_needUnlockInteraction.load()) {
-                if (chrono::high_resolution_clock::now() - _interactionUnlockTime.load() >
-                    chrono::milliseconds(_configInteractionUnlockDelay)) {
-                    _needUnlockInteraction.store(false);
-                    _interactionMutex.unlock_shared();
-                }
-            }
-            this_thread::sleep_for(10ms);
+void InteractionMonitor::_scheduleReleaseInteractionLock(const chrono::milliseconds delay) {
+    _releaseInteractionLockTask = TaskScheduler::GetInstance()->schedule(delay, [this] {
+        const auto unlockDelay = _configInteractionUnlockDelay.load();
+        if (const auto pastTime = chrono::high_resolution_clock::now() - _interactionUnlockTime.load();
+            pastTime > unlockDelay) {
+            _needUnlockInteraction.store(false);
+            _interactionMutex.unlock_shared();
+        } else {
+            _scheduleReleaseInteractionLock(
+                chrono::duration_cast<chrono::milliseconds>(unlockDelay - pastTime) + 1ms
+            );
         }
-    }).detach();
+    });
 }
@@ -7,6 +7,7 @@
 
 #include <singleton_dclp.hpp>
 
+#include <components/TaskScheduler.h>
 #include <models/configs.h>
 #include <types/common.h>
 #include <types/CaretPosition.h>
@@ -47,7 +48,7 @@ namespace components {
 
     private:
         mutable std::shared_mutex _configCommitMutex, _configManualCompletionMutex, _interactionMutex;
-        std::atomic<bool> _isRunning{true}, _isSelecting{false}, _needUnlockInteraction{false};
+        std::atomic<bool> _isSelecting{false}, _needUnlockInteraction{false};
         std::atomic<std::chrono::milliseconds> _configInteractionUnlockDelay{std::chrono::milliseconds(50)};
         std::atomic<std::chrono::seconds> _configAutoSaveInterval{std::chrono::seconds(300)};
         std::atomic<std::optional<types::Mouse>> _navigateWithMouse;
@@ -57,6 +58,7 @@ namespace components {
         std::shared_ptr<void> _cbtHookHandle, _keyHookHandle, _mouseHookHandle, _processHandle, _windowHookHandle;
         std::unordered_map<types::Interaction, std::vector<Handler>> _handlerMap;
         types::KeyCombination _configCommit, _configManualCompletion;
+        TaskScheduler::Handle _autoSaveTask, _monitorCaretPositionTask, _releaseInteractionLockTask;
 
         static long __stdcall _cbtProcedureHook(int nCode, unsigned int wParam, long lParam);
 
@@ -82,10 +84,10 @@ namespace components {
 
         void _retrieveProjectId(const std::string& project) const;
 
-        void _threadAutoSave() const;
+        void _scheduleAutoSave();
 
-        void _threadMonitorCaretPosition();
+        void _scheduleMonitorCaretPosition();
 
-        void _threadReleaseInteractionLock();
+        void _scheduleReleaseInteractionLock(std::chrono::milliseconds delay);
     };
 }
@@ -10,13 +10,13 @@ using namespace types;
 using namespace utils;
 
 StatisticManager::StatisticManager() {
-    _threadReportEditedCompletions();
+    _scheduleReportEditedCompletions();
 
     logger::info("StatisticManager is initialized.");
 }
 
 StatisticManager::~StatisticManager() {
-    _isRunning.store(false);
+    _reportEditedCompletionsTask.cancel();
 }
 
 uint32_t StatisticManager::addLine(const uint32_t line, const uint32_t count) {
@@ -89,27 +89,24 @@ void StatisticManager::updateStatisticConfig(const models::StatisticConfig& comp
     }
 }
 
-void StatisticManager::_threadReportEditedCompletions() {
-    thread([this] {
-        while (_isRunning) {
-            if (_configCheckEditedCompletion.load()) {
-                vector<EditedCompletion> needReportCompletions{}; {
-                    const shared_lock lock(_editedCompletionMapMutex);
-                    for (const auto& editedCompletion: _editedCompletionMap | views::values) {
-                        if (editedCompletion.canReport()) {
-                            needReportCompletions.push_back(editedCompletion);
-                        }
-                    }
-                } {
-                    const auto interactionLock = InteractionMonitor::GetInstance()->getInteractionLock();
-                    const unique_lock editedCompletionMapLock(_editedCompletionMapMutex);
-                    for (const auto& needReportCompletion: needReportCompletions) {
-                        _editedCompletionMap.erase(needReportCompletion.actionId);
-                        WebsocketManager::GetInstance()->send(needReportCompletion.parse());
+void StatisticManager::_scheduleReportEditedCompletions() {
+    _reportEditedCompletionsTask = TaskScheduler::GetInstance()->scheduleEvery(5s, [this] {
+        if (_configCheckEditedCompletion.load()) {
+            vector<EditedCompletion> needReportCompletions{}; {
+                const shared_lock lock(_editedCompletionMapMutex);
+                for (const auto& editedCompletion: _editedCompletionMap | views::values) {
+                    if (editedCompletion.canReport()) {
+                        needReportCompletions.push_back(editedCompletion);
                     }
                 }
+            } {
+                const auto interactionLock = InteractionMonitor::GetInstance()->getInteractionLock();
+                const unique_lock editedCompletionMapLock(_editedCompletionMapMutex);
+                for (const auto& needReportCompletion: needReportCompletions) {
+                    _editedCompletionMap.erase(needReportCompletion.actionId);
+                    WebsocketManager::GetInstance()->send(needReportCompletion.parse());
+                }
             }
-            this_thread::sleep_for(5s);
         }
-    }).detach();
+    });
 }
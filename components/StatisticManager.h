@@ -2,6 +2,7 @@
 
 #include <singleton_dclp.hpp>
 
+#include <components/TaskScheduler.h>
 #include <types/EditedCompletion.h>
 
 namespace components {
@@ -23,9 +24,10 @@ namespace components {
 
     private:
         mutable std::shared_mutex _editedCompletionMapMutex;
-        std::atomic<bool> _configCheckEditedCompletion{false}, _isRunning{true};
+        std::atomic<bool> _configCheckEditedCompletion{false};
         std::unordered_map<std::string, types::EditedCompletion> _editedCompletionMap;
+        TaskScheduler::Handle _reportEditedCompletionsTask;
 
-        void _threadReportEditedCompletions();
+        void _scheduleReportEditedCompletions();
     };
 }
@@ -1,22 +1,28 @@
+#include <bit>
 #include <filesystem>
+#include <fstream>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <ranges>
-#include <regex>
 #include <unordered_set>
+#include <utility>
 
 #include <magic_enum/magic_enum.hpp>
 #include <nlohmann/json.hpp>
-#include <readtags.h>
 
 #include <components/MemoryManipulator.h>
 #include <components/SymbolManager.h>
 #include <types/TagEntry.h>
+#include <types/TagManifest.h>
+#include <utils/common.h>
 #include <utils/fs.h>
 #include <utils/iconv.h>
 #include <utils/logger.h>
 #include <utils/system.h>
 
+#include <emmintrin.h>
+
 using namespace components;
 using namespace magic_enum;
 using namespace models;
@@ -26,7 +32,7 @@ using namespace utils;
 
 namespace {
     struct SymbolCollection {
-        unordered_set<string> globalVariables, references, unknown;
+        unordered_set<string_view> globalVariables, references, unknown;
     };
 
     const unordered_map<string, SymbolInfo::Type> symbolMapping =
@@ -53,9 +59,20 @@ namespace {
         "tools",
         "ut"
     };
-    const auto symbolPattern = regex(R"~(\b[A-Z_a-z][0-9A-Z_a-z]+\b)~");
+    constexpr auto identifierTable = [] {
+        array<bool, 256> table{};
+        for (auto character = '0'; character <= '9'; ++character) {
+            table[character] = true;
+        }
+        for (auto character = 'A'; character <= 'Z'; ++character) {
+            table[character] = true;
+            table[character + ('a' - 'A')] = true;
+        }
+        table['_'] = true;
+        return table;
+    }();
 
-    const unordered_set<string> ignoredWords{
+    const unordered_set<string_view> ignoredWords{
         // C keywords
         "alignas",
         "alignof",
@@ -212,23 +229,53 @@ namespace {
         "X86PLAT/src",
     };
 
-    SymbolCollection collectSymbols(const string& prefixLines) {
-        SymbolCollection result;
-        vector<string> symbolList;
-        copy(
-            sregex_token_iterator(prefixLines.begin(), prefixLines.end(), symbolPattern),
-            sregex_token_iterator(),
-            back_inserter(symbolList)
+    uint32_t identifierMask(const char* data) {
+        const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+        const auto lowerChunk = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+        const auto isAlpha = _mm_and_si128(
+            _mm_cmpgt_epi8(lowerChunk, _mm_set1_epi8('a' - 1)),
+            _mm_cmplt_epi8(lowerChunk, _mm_set1_epi8('z' + 1))
         );
-        for (const auto& symbol: symbolList) {
-            if (symbol.length() < 8 || ignoredWords.contains(symbol)) {
+        const auto isDigit = _mm_and_si128(
+            _mm_cmpgt_epi8(chunk, _mm_set1_epi8('0' - 1)),
+            _mm_cmplt_epi8(chunk, _mm_set1_epi8('9' + 1))
+        );
+        const auto isUnderscore = _mm_cmpeq_epi8(chunk, _mm_set1_epi8('_'));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(isAlpha, isDigit), isUnderscore)));
+    }
+
+    size_t skipCharacters(const string_view content, size_t offset, const bool isIdentifier) {
+        while (offset + 16 <= content.size()) {
+            auto stopMask = identifierMask(content.data() + offset);
+            if (isIdentifier) {
+                stopMask = ~stopMask & 0xFFFF;
+            }
+            if (stopMask) {
+                return offset + countr_zero(stopMask);
+            }
+            offset += 16;
+        }
+        while (offset < content.size() && identifierTable[static_cast<uint8_t>(content[offset])] == isIdentifier) {
+            ++offset;
+        }
+        return offset;
+    }
+
+    SymbolCollection collectSymbols(const string_view prefixLines) {
+        SymbolCollection result;
+        size_t offset = 0;
+        while ((offset = skipCharacters(prefixLines, offset, false)) < prefixLines.size()) {
+            const auto symbolEnd = skipCharacters(prefixLines, offset, true);
+            const auto symbol = prefixLines.substr(offset, symbolEnd - offset);
+            offset = symbolEnd;
+            if (isdigit(static_cast<uint8_t>(symbol.front())) ||
+                symbol.length() < 8 || ignoredWords.contains(symbol)) {
                 continue;
             }
 
-            if (symbol.substr(0, 2) == "g_") {
+            if (symbol.starts_with("g_")) {
                 result.globalVariables.emplace(symbol);
-            } else if (const auto lastTwoChars = symbol.substr(symbol.length() - 2);
-                lastTwoChars == "_E" || lastTwoChars == "_S") {
+            } else if (symbol.ends_with("_E") || symbol.ends_with("_S")) {
                 result.references.emplace(symbol);
             } else {
                 result.unknown.emplace(symbol);
@@ -237,50 +284,50 @@ namespace {
         return result;
     }
 
-    optional<TagEntry> findMostCommonPathSymbol(
-        const shared_ptr<tagFile>& tagFileHandle,
-        const string& symbol,
-        const filesystem::path& referencePath
+    void mergeTagFile(
+        const filesystem::path& originalPath,
+        const filesystem::path& deltaPath,
+        const unordered_set<string>& excludedFiles,
+        const filesystem::path& outputPath
     ) {
-        uint32_t mostCommonPathLength{};
-        tagEntry entry{};
-        optional<TagEntry> result;
-        if (tagsFind(tagFileHandle.get(), &entry, symbol.c_str(), TAG_OBSERVECASE) == TagSuccess) {
-            const auto referencePathString = referencePath.generic_string();
-            if (const auto pathDistance = distance(
-                referencePathString.cbegin(), ranges::mismatch(
-                    referencePathString,
-                    iconv::toPath(entry.file).generic_string()
-                ).in1
-            ); pathDistance > mostCommonPathLength) {
-                mostCommonPathLength = pathDistance;
-                result.emplace(entry);
-            }
-            while (tagsFindNext(tagFileHandle.get(), &entry) == TagSuccess) {
-                if (const auto pathDistance = distance(
-                    referencePathString.cbegin(), ranges::mismatch(
-                        referencePathString,
-                        iconv::toPath(entry.file).generic_string()
-                    ).in1
-                ); pathDistance > mostCommonPathLength) {
-                    mostCommonPathLength = pathDistance;
-                    result.emplace(entry);
+        auto outputStream = ofstream{outputPath, ios::binary | ios::trunc};
+        outputStream.exceptions(ios_base::badbit | ios_base::failbit);
+        string line; {
+            auto originalStream = ifstream{originalPath, ios::binary};
+            while (getline(originalStream, line)) {
+                if (line.starts_with("!_TAG_FILE_SORTED\t")) {
+                    outputStream << "!_TAG_FILE_SORTED\t0\t/0=unsorted, 1=sorted, 2=foldcase/\n";
+                    continue;
+                }
+                if (!line.starts_with("!_")) {
+                    const auto fileBegin = line.find('\t');
+                    const auto fileEnd = line.find('\t', fileBegin + 1);
+                    if (fileBegin == string::npos || fileEnd == string::npos || excludedFiles.contains(
+                            TagManifest::normalize(string_view(line).substr(fileBegin + 1, fileEnd - fileBegin - 1))
+                        )) {
+                        continue;
+                    }
                 }
+                outputStream << line << '\n';
+            }
+        }
+        auto deltaStream = ifstream{deltaPath, ios::binary};
+        while (getline(deltaStream, line)) {
+            if (!line.starts_with("!_")) {
+                outputStream << line << '\n';
             }
         }
-        return result;
     }
 
     void collectCommonSymbols(
-        const shared_ptr<tagFile>& tagFileHandle,
-        const unordered_set<string>& symbolNames,
+        const TagIndex& tagIndex,
+        const unordered_set<string_view>& symbolNames,
         const filesystem::path& referencePath,
         vector<SymbolInfo>& result
     ) {
         for (const auto& symbolString: symbolNames) {
             try {
-                if (const auto symbolEntryOpt = findMostCommonPathSymbol(
-                    tagFileHandle,
+                if (const auto symbolEntryOpt = tagIndex.findNearest(
                     symbolString,
                     referencePath
                 ); symbolEntryOpt.has_value()) {
@@ -317,10 +364,7 @@ namespace {
     }
 }
 
-SymbolManager::SymbolManager() {
-    _threadUpdateFunctionTagFile();
-    _threadUpdateStructureTagFile();
-}
+SymbolManager::SymbolManager() = default;
 
 SymbolManager::~SymbolManager() {
     _isRunning.store(false);
@@ -329,60 +373,222 @@ SymbolManager::~SymbolManager() {
 unordered_map<string, ReviewReference> SymbolManager::getReviewReferences(
     const string& content,
     const filesystem::path& referencePath,
-    const uint32_t targetDepth
+    const uint32_t targetDepth,
+    const Time deadline,
+    const uint32_t maxReferenceCount,
+    const uint64_t maxReferenceBytes
 ) const {
-    uint32_t currentDepth = 0;
-    auto reviewReferences = _getReferences(content, referencePath, currentDepth);
-
-    while (currentDepth < targetDepth) {
-        ++currentDepth;
-
-        mutex reviewReferencesMutex;
-        vector<thread> retrieveReferenceThreads;
-        retrieveReferenceThreads.reserve(reviewReferences.size());
-        for (auto& [key, value]: unordered_map{reviewReferences}) {
-            retrieveReferenceThreads.emplace_back(
-                [tempContent = move(value.content), tempPath = move(value.path),
-                    currentDepth, &reviewReferences, &reviewReferencesMutex, this] {
-                    auto tempReferences = _getReferences(tempContent, tempPath, currentDepth);
-                    unique_lock lock{reviewReferencesMutex};
-                    reviewReferences.merge(move(tempReferences));
+    const auto referencePathString = referencePath.generic_string();
+    const auto isCancelled = [this, deadline] {
+        return !_isRunning || chrono::high_resolution_clock::now() >= deadline;
+    };
+    unordered_map<string, ReviewReference> reviewReferences;
+    uint64_t referenceBytes{};
+    vector<string> frontierKeys;
+
+    for (uint32_t depth = 0; depth <= targetDepth && !isCancelled(); ++depth) {
+        mutex candidatesMutex;
+        unordered_map<string, SymbolInfo> candidates; {
+            const WorkStealingPool::TaskGroup taskGroup(_referencePool);
+            const auto collectCandidates = [&](const string& tempContent, const filesystem::path& tempPath) {
+                taskGroup.submit([&, this] {
+                    if (isCancelled()) {
+                        taskGroup.cancel();
+                        return;
+                    }
+                    for (auto& symbol: getSymbols(tempContent, tempPath, true)) {
+                        if (ranges::any_of(excludePatterns, [&symbol](const auto& pattern) {
+                            return symbol.path.generic_string().contains(pattern);
+                        })) {
+                            continue;
+                        }
+                        if (auto key = format("{}:{}", symbol.path.generic_string(), symbol.name);
+                            !reviewReferences.contains(key)) {
+                            unique_lock lock{candidatesMutex};
+                            candidates.try_emplace(move(key), move(symbol));
+                        }
+                    }
+                });
+            };
+            if (depth == 0) {
+                collectCandidates(content, referencePath);
+            } else {
+                for (const auto& key: frontierKeys) {
+                    const auto& reviewReference = reviewReferences.at(key);
+                    collectCandidates(reviewReference.content, reviewReference.path);
                 }
-            );
+            }
+            taskGroup.wait();
+        }
+        if (isCancelled()) {
+            break;
         }
-        for (auto& retrieveReferenceThread: retrieveReferenceThreads) {
-            retrieveReferenceThread.join();
+
+        vector<pair<string, SymbolInfo>> orderedCandidates(
+            make_move_iterator(candidates.begin()), make_move_iterator(candidates.end())
+        );
+        vector<size_t> proximities;
+        proximities.reserve(orderedCandidates.size());
+        for (const auto& symbol: orderedCandidates | views::values) {
+            const auto pathString = symbol.path.generic_string();
+            proximities.push_back(distance(
+                referencePathString.cbegin(), ranges::mismatch(referencePathString, pathString).in1
+            ));
+        }
+        vector<size_t> order(orderedCandidates.size());
+        iota(order.begin(), order.end(), 0);
+        ranges::sort(order, [&](const size_t left, const size_t right) {
+            if (proximities[left] != proximities[right]) {
+                return proximities[left] > proximities[right];
+            }
+            return orderedCandidates[left].first < orderedCandidates[right].first;
+        });
+        order.resize(min<size_t>(order.size(), maxReferenceCount - reviewReferences.size()));
+
+        vector<optional<ReviewReference>> loadedReferences(order.size()); {
+            const WorkStealingPool::TaskGroup taskGroup(_referencePool);
+            for (size_t index = 0; index < order.size(); ++index) {
+                taskGroup.submit([&, depth, index, this] {
+                    if (isCancelled()) {
+                        taskGroup.cancel();
+                        return;
+                    }
+                    loadedReferences[index] = _readReference(orderedCandidates[order[index]].second, depth);
+                });
+            }
+            taskGroup.wait();
+        }
+
+        frontierKeys.clear();
+        for (size_t index = 0; index < order.size(); ++index) {
+            if (!loadedReferences[index].has_value() ||
+                referenceBytes + loadedReferences[index]->content.size() > maxReferenceBytes) {
+                continue;
+            }
+            referenceBytes += loadedReferences[index]->content.size();
+            auto& key = orderedCandidates[order[index]].first;
+            if (depth < targetDepth) {
+                frontierKeys.push_back(key);
+            }
+            reviewReferences.emplace(move(key), move(loadedReferences[index].value()));
+        }
+        if (frontierKeys.empty() || reviewReferences.size() >= maxReferenceCount) {
+            break;
         }
     }
+    logger::debug(format(
+        "Collected {} review references ({} bytes) within depth {}{}",
+        reviewReferences.size(),
+        referenceBytes,
+        targetDepth,
+        isCancelled() ? " before cancellation" : ""
+    ));
 
     return reviewReferences;
 }
 
+pair<uint64_t, uint64_t> SymbolManager::getSymbolCacheStatistics() const {
+    return {_symbolCacheHitCount.load(), _symbolCacheMissCount.load()};
+}
+
 vector<SymbolInfo> SymbolManager::getSymbols(
     const string& content,
     const filesystem::path& referencePath,
     const bool full
 ) const {
+    const auto cacheKey = common::hash(
+        format("{}\t{}\t{}", referencePath.generic_string(), _tagGeneration.load(), full),
+        common::hash(content)
+    ); {
+        unique_lock lock{_symbolCacheMutex};
+        if (auto symbolsOpt = _symbolCache.get(cacheKey);
+            symbolsOpt.has_value()) {
+            ++_symbolCacheHitCount;
+            return move(symbolsOpt.value());
+        }
+    }
+    logger::debug(format(
+        "Symbol cache missed. Hits: {}, misses: {}", _symbolCacheHitCount.load(), ++_symbolCacheMissCount
+    ));
+    auto result = _getSymbols(content, referencePath, full); {
+        unique_lock lock{_symbolCacheMutex};
+        _symbolCache.put(cacheKey, result);
+    }
+    return result;
+}
+
+void SymbolManager::updateGenericConfig(const GenericConfig& genericConfig) {
+    if (const auto useBuiltinTagExtractorOpt = genericConfig.useBuiltinTagExtractor;
+        useBuiltinTagExtractorOpt.has_value()) {
+        const auto useBuiltinTagExtractor = useBuiltinTagExtractorOpt.value();
+        logger::info(format("Update use builtin tag extractor: {}", useBuiltinTagExtractor));
+        _configUseBuiltinTagExtractor.store(useBuiltinTagExtractor);
+    }
+}
+
+void SymbolManager::updateRootPath(const filesystem::path& currentFilePath) {
+    _updatePool.submit([this, originalPath = absolute(currentFilePath).lexically_normal()] {
+        auto tempPath = originalPath;
+        while (tempPath != tempPath.parent_path()) {
+            if (ranges::any_of(modulePaths, [&tempPath](const auto& modulePath) {
+                return exists(tempPath / modulePath);
+            })) {
+                bool isSameRoot; {
+                    shared_lock lock{_rootPathMutex};
+                    isSameRoot = tempPath == _rootPath;
+                }
+                if (!isSameRoot) {
+                    logger::info(format("Root path updated to Comware style: '{}'", tempPath.generic_string()));
+                    unique_lock lock{_rootPathMutex};
+                    _rootPath = tempPath;
+                }
+                _watchRootPath(tempPath);
+                return;
+            }
+            tempPath = tempPath.parent_path();
+        }
+        tempPath = originalPath;
+        while (tempPath != tempPath.parent_path()) {
+            if (exists(tempPath / "src")) {
+                bool isSameRoot; {
+                    shared_lock lock{_rootPathMutex};
+                    isSameRoot = tempPath == _rootPath;
+                }
+                if (!isSameRoot) {
+                    logger::info(format("Root path updated to normal style: '{}'", tempPath.generic_string()));
+                    unique_lock lock{_rootPathMutex};
+                    _rootPath = tempPath;
+                }
+                _watchRootPath(tempPath);
+                return;
+            }
+            tempPath = tempPath.parent_path();
+        }
+    });
+}
+
+vector<SymbolInfo> SymbolManager::_getSymbols(
+    const string& content,
+    const filesystem::path& referencePath,
+    const bool full
+) const {
+    const auto symbolCollection = collectSymbols(content);
     vector<SymbolInfo> result; {
-        const auto tagFilePath = MemoryManipulator::GetInstance()->getProjectDirectory()
-                                 / _tagFilenameMap.at(TagFileType::Structure).first;
-        if (!exists(tagFilePath)) {
+        if (!_loadTagIndex(TagFileType::Structure)) {
             return result;
         }
 
         shared_lock lock{_structureTagFileMutex};
-        const shared_ptr<tagFile> tagFileHandle(tagsOpen(tagFilePath.generic_string().c_str(), nullptr), tagsClose);
-        if (tagFileHandle == nullptr) {
-            logger::warn(format("Failed to open '{}'", tagFilePath.generic_string()));
+        if (!_tagIndexes[enum_integer(TagFileType::Structure)]) {
             return result;
         }
+        const auto& tagIndex = *_tagIndexes[enum_integer(TagFileType::Structure)];
 
-        collectCommonSymbols(tagFileHandle, collectSymbols(content).globalVariables, referencePath, result);
+        collectCommonSymbols(tagIndex, symbolCollection.globalVariables, referencePath, result);
 
-        for (const auto& typeReferenceString: collectSymbols(content).references) {
+        for (const auto& typeReferenceString: symbolCollection.references) {
             try {
-                if (const auto referenceEntryOpt = findMostCommonPathSymbol(
-                    tagFileHandle,
+                if (const auto referenceEntryOpt = tagIndex.findNearest(
                     typeReferenceString,
                     referencePath
                 ); referenceEntryOpt.has_value()) {
@@ -390,8 +596,7 @@ vector<SymbolInfo> SymbolManager::getSymbols(
                         referenceTargetOpt.has_value()) {
                         if (const auto& [targetType, targetString] = referenceTargetOpt.value();
                             symbolMapping.contains(targetType)) {
-                            if (const auto targetEntryOpt = findMostCommonPathSymbol(
-                                tagFileHandle,
+                            if (const auto targetEntryOpt = tagIndex.findNearest(
                                 targetString,
                                 referencePath
                             ); targetEntryOpt.has_value()) {
@@ -434,17 +639,15 @@ vector<SymbolInfo> SymbolManager::getSymbols(
             }
         }
 
-        for (const auto& unknownString: collectSymbols(content).unknown) {
+        for (const auto& unknownString: symbolCollection.unknown) {
             try {
-                if (const auto unknownEntryOpt = findMostCommonPathSymbol(
-                    tagFileHandle,
+                if (const auto unknownEntryOpt = tagIndex.findNearest(
                     unknownString,
                     referencePath
                 ); unknownEntryOpt.has_value()) {
                     if (const auto enumTargetOpt = unknownEntryOpt.value().getEnumTarget();
                         enumTargetOpt.has_value()) {
-                        if (const auto enumEntryOpt = findMostCommonPathSymbol(
-                            tagFileHandle,
+                        if (const auto enumEntryOpt = tagIndex.findNearest(
                             enumTargetOpt.value(),
                             referencePath
                         ); enumEntryOpt.has_value()) {
@@ -473,160 +676,323 @@ vector<SymbolInfo> SymbolManager::getSymbols(
         }
     }
     if (full) {
-        const auto tagFilePath = MemoryManipulator::GetInstance()->getProjectDirectory()
-                                 / _tagFilenameMap.at(TagFileType::Function).first;
-        if (!exists(tagFilePath)) {
+        if (!_loadTagIndex(TagFileType::Function)) {
             return result;
         }
 
         shared_lock lock{_functionTagFileMutex};
-        const shared_ptr<tagFile> tagFileHandle(tagsOpen(tagFilePath.generic_string().c_str(), nullptr), tagsClose);
-        if (tagFileHandle == nullptr) {
-            logger::warn(format("Failed to open '{}'", tagFilePath.generic_string()));
+        if (!_tagIndexes[enum_integer(TagFileType::Function)]) {
             return result;
         }
+        const auto& tagIndex = *_tagIndexes[enum_integer(TagFileType::Function)];
 
-        collectCommonSymbols(tagFileHandle, collectSymbols(content).unknown, referencePath, result);
+        collectCommonSymbols(tagIndex, symbolCollection.unknown, referencePath, result);
     }
     return result;
 }
 
-void SymbolManager::updateRootPath(const filesystem::path& currentFilePath) {
-    _tagFileNeedUpdateMap.at(TagFileType::Function) = true;
-    _tagFileNeedUpdateMap.at(TagFileType::Structure) = true;
-    thread([this, originalPath = absolute(currentFilePath).lexically_normal()] {
-        auto tempPath = originalPath;
-        while (tempPath != tempPath.parent_path()) {
-            if (ranges::any_of(modulePaths, [&tempPath](const auto& modulePath) {
-                return exists(tempPath / modulePath);
-            })) {
-                bool isSameRoot; {
-                    shared_lock lock{_rootPathMutex};
-                    isSameRoot = tempPath == _rootPath;
-                }
-                if (!isSameRoot) {
-                    logger::info(format("Root path updated to Comware style: '{}'", tempPath.generic_string()));
-                    unique_lock lock{_rootPathMutex};
-                    _rootPath = tempPath;
-                }
-                return;
-            }
-            tempPath = tempPath.parent_path();
-        }
-        tempPath = originalPath;
-        while (tempPath != tempPath.parent_path()) {
-            if (exists(tempPath / "src")) {
-                bool isSameRoot; {
-                    shared_lock lock{_rootPathMutex};
-                    isSameRoot = tempPath == _rootPath;
-                }
-                if (!isSameRoot) {
-                    logger::info(format("Root path updated to normal style: '{}'", tempPath.generic_string()));
-                    unique_lock lock{_rootPathMutex};
-                    _rootPath = tempPath;
-                }
-                return;
-            }
-            tempPath = tempPath.parent_path();
-        }
-    }).detach();
+shared_mutex& SymbolManager::_getTagFileMutex(const TagFileType tagFileType) const {
+    return tagFileType == TagFileType::Function ? _functionTagFileMutex : _structureTagFileMutex;
 }
 
-unordered_map<string, ReviewReference> SymbolManager::_getReferences(
-    const string& content,
-    const filesystem::path& referencePath,
-    const uint32_t depth
-) const {
-    const auto symbols = getSymbols(content, referencePath, true);
-    mutex reviewReferencesMutex;
-    unordered_map<string, ReviewReference> reviewReferences;
-    vector<thread> retrieveContentThreads;
-    reviewReferences.reserve(symbols.size());
-    retrieveContentThreads.reserve(symbols.size());
-
-    for (const auto& [path, name, type, startLine, endLine]: symbols) {
-        if (ranges::any_of(excludePatterns, [&path](const auto& pattern) {
-            return path.generic_string().contains(pattern);
-        })) {
-            continue;
-        }
-
-        retrieveContentThreads.emplace_back([&] {
-            auto reviewReference = ReviewReference{
-                path,
-                name,
-                iconv::autoDecode(fs::readFile(
-                    path.generic_string(),
-                    startLine,
-                    endLine
-                )),
-                type,
-                startLine,
-                endLine,
-                depth
-            };
-
-            unique_lock lock{reviewReferencesMutex};
-            reviewReferences.emplace(format("{}:{}", path.generic_string(), name), move(reviewReference));
-        });
+bool SymbolManager::_loadTagIndex(const TagFileType tagFileType) const {
+    const auto tagFilePath = MemoryManipulator::GetInstance()->getProjectDirectory()
+                             / _tagFilenameMap.at(tagFileType).first; {
+        shared_lock lock{_getTagFileMutex(tagFileType)};
+        if (const auto& tagIndex = _tagIndexes[enum_integer(tagFileType)];
+            tagIndex && tagIndex->path() == tagFilePath) {
+            return true;
+        }
     }
-
-    for (auto& thread: retrieveContentThreads) {
-        thread.join();
+    if (!exists(tagFilePath)) {
+        return false;
     }
 
-    return reviewReferences;
+    unique_lock lock{_getTagFileMutex(tagFileType)};
+    auto& tagIndex = _tagIndexes[enum_integer(tagFileType)];
+    if (tagIndex && tagIndex->path() == tagFilePath) {
+        return true;
+    }
+    try {
+        tagIndex = make_unique<TagIndex>(tagFilePath);
+        ++_tagGeneration;
+        logger::info(format("Loaded {} tags from '{}'", tagIndex->size(), tagFilePath.generic_string()));
+        return true;
+    } catch (exception& e) {
+        logger::warn(format("Exception when loading tags: {}", e.what()));
+    }
+    return false;
 }
 
-void SymbolManager::_threadUpdateFunctionTagFile() {
-    thread([this] {
-        while (_isRunning) {
-            _updateTagFile(TagFileType::Function);
-            this_thread::sleep_for(1s);
+optional<ReviewReference> SymbolManager::_readReference(const SymbolInfo& symbol, const uint32_t depth) const {
+    const auto& [path, name, type, startLine, endLine] = symbol;
+    string referenceContent;
+    try {
+        _referenceReadSemaphore.acquire();
+        try {
+            referenceContent = fs::readFile(path.generic_string(), startLine, endLine);
+        } catch (...) {
+            _referenceReadSemaphore.release();
+            throw;
         }
-    }).detach();
+        _referenceReadSemaphore.release();
+    } catch (exception& e) {
+        logger::warn(format("Exception when reading '{}': {}", name, e.what()));
+        return nullopt;
+    }
+    return ReviewReference{
+        path,
+        name,
+        iconv::autoDecode(referenceContent),
+        type,
+        startLine,
+        endLine,
+        depth
+    };
 }
 
-void SymbolManager::_threadUpdateStructureTagFile() {
-    thread([this] {
-        while (_isRunning) {
-            _updateTagFile(TagFileType::Structure);
-            this_thread::sleep_for(1s);
+void SymbolManager::_scheduleTagFileUpdate(const TagFileType tagFileType) {
+    vector tagFileTypes{tagFileType};
+    if (_configUseBuiltinTagExtractor.load()) {
+        const auto& allTagFileTypes = enum_values<TagFileType>();
+        tagFileTypes.assign(allTagFileTypes.begin(), allTagFileTypes.end());
+    }
+    if (ranges::any_of(tagFileTypes, [this](const TagFileType type) {
+        return _tagFileUpdatingMap.at(type);
+    })) {
+        return;
+    }
+    for (const auto type: tagFileTypes) {
+        _tagFileUpdatingMap.at(type) = true;
+    }
+    _updatePool.submit([this, tagFileTypes] {
+        const auto hasPendingUpdate = [this](const TagFileType type) {
+            return _tagFileNeedUpdateMap.at(type) || !_tagFileDirtyFilesMap.at(type).empty();
+        };
+        while (true) {
+            try {
+                _updateTagFiles(tagFileTypes);
+            } catch (const exception& e) {
+                logger::warn(format("(_scheduleTagFileUpdate) Exception: {}", e.what()));
+            }
+            unique_lock lock{_tagFileUpdateMutex};
+            if (_isRunning && ranges::any_of(tagFileTypes, hasPendingUpdate)) {
+                continue;
+            }
+            for (const auto type: tagFileTypes) {
+                _tagFileUpdatingMap.at(type) = false;
+            }
+            for (const auto type: enum_values<TagFileType>()) {
+                if (_isRunning && !_tagFileUpdatingMap.at(type) && hasPendingUpdate(type)) {
+                    _scheduleTagFileUpdate(type);
+                }
+            }
+            return;
         }
-    }).detach();
+    });
 }
 
-void SymbolManager::_updateTagFile(const TagFileType tagFileType) {
-    if (_tagFileNeedUpdateMap[tagFileType]) {
-        const auto currentProjectDirectory = MemoryManipulator::GetInstance()->getProjectDirectory();
-        const auto tagFilePath = currentProjectDirectory / _tagFilenameMap.at(tagFileType).first;
-        const auto tempTagFilePath = currentProjectDirectory / _tagFilenameMap.at(tagFileType).second;
-        string arguments; {
-            shared_lock lock{_rootPathMutex};
-            if (_rootPath.empty() || !exists(_rootPath)) {
-                _tagFileNeedUpdateMap[tagFileType] = false;
-                return;
-            }
-            arguments = format(
-                R"(--excmd=combine -f "{}" --fields=+e+n --kinds-c={} --languages=C,C++ -R "{}")",
-                tempTagFilePath.generic_string(),
-                _tagKindsMap.at(tagFileType),
-                _rootPath.generic_string()
+void SymbolManager::_updateTagFiles(const vector<TagFileType>& tagFileTypes) {
+    struct TagFileUpdate {
+        TagFileType tagFileType;
+        filesystem::path tagFilePath, tempTagFilePath, manifestPath, listPath, deltaPath;
+        TagManifest manifest;
+        optional<TagManifest::Difference> differenceOpt;
+        vector<string> files;
+    };
+
+    vector<tuple<TagFileType, bool, unordered_set<string>>> pendingUpdates; {
+        unique_lock lock{_tagFileUpdateMutex};
+        for (const auto tagFileType: tagFileTypes) {
+            pendingUpdates.emplace_back(
+                tagFileType,
+                exchange(_tagFileNeedUpdateMap.at(tagFileType), false),
+                exchange(_tagFileDirtyFilesMap.at(tagFileType), {})
             );
         }
+    }
+    const auto currentProjectDirectory = MemoryManipulator::GetInstance()->getProjectDirectory();
+    filesystem::path rootPath; {
+        shared_lock lock{_rootPathMutex};
+        rootPath = _rootPath;
+    }
+    if (rootPath.empty() || !exists(rootPath)) {
+        return;
+    }
+
+    vector<TagFileUpdate> updates;
+    optional<TagManifest> scannedManifestOpt;
+    for (const auto& [tagFileType, needFullUpdate, dirtyFiles]: pendingUpdates) {
         try {
+            const auto tagFilePath = currentProjectDirectory / _tagFilenameMap.at(tagFileType).first;
+            const auto tempTagFilePath = currentProjectDirectory / _tagFilenameMap.at(tagFileType).second;
+            const auto [manifestFilename, listFilename, deltaFilename] = _tagIncrementFilenameMap.at(tagFileType);
+            const auto manifestPath = currentProjectDirectory / manifestFilename;
+            const auto deltaPath = currentProjectDirectory / deltaFilename;
+            const auto previousManifestOpt = exists(tagFilePath) ? TagManifest::load(manifestPath) : nullopt;
+            const auto isIncremental = previousManifestOpt.has_value() &&
+                                       previousManifestOpt.value().rootPath() == rootPath;
+            if (!isIncremental || needFullUpdate) {
+                if (!scannedManifestOpt.has_value()) {
+                    scannedManifestOpt.emplace(rootPath);
+                }
+            }
+            auto manifest = !needFullUpdate && isIncremental
+                                ? previousManifestOpt.value().update(dirtyFiles)
+                                : scannedManifestOpt.value();
             if (exists(tempTagFilePath)) {
                 remove(tempTagFilePath);
             }
-            system::runCommand("ctags.exe", arguments);
-            unique_lock lock{tagFileType == TagFileType::Function ? _functionTagFileMutex : _structureTagFileMutex};
-            rename(
+            optional<TagManifest::Difference> differenceOpt;
+            vector<string> files;
+            if (isIncremental) {
+                auto difference = manifest.compare(previousManifestOpt.value());
+                if (difference.empty()) {
+                    continue;
+                }
+                logger::info(format(
+                    "Incrementally updating {} tags. Changed: {}, removed: {}",
+                    enum_name(tagFileType),
+                    difference.changedFiles.size(),
+                    difference.removedFiles.size()
+                ));
+                if (exists(deltaPath)) {
+                    remove(deltaPath);
+                }
+                files.assign(difference.changedFiles.begin(), difference.changedFiles.end());
+                differenceOpt.emplace(move(difference));
+            } else {
+                logger::info(format(
+                    "Fully rebuilding {} tags under '{}'", enum_name(tagFileType), rootPath.generic_string()
+                ));
+                files = manifest.files();
+            }
+            ranges::sort(files);
+            updates.push_back({
+                tagFileType,
+                tagFilePath,
                 tempTagFilePath,
-                tagFilePath
-            );
+                manifestPath,
+                currentProjectDirectory / listFilename,
+                deltaPath,
+                move(manifest),
+                move(differenceOpt),
+                move(files)
+            });
         } catch (exception& e) {
-            logger::warn(format("Exception when updating tags: {}", e.what()));
+            logger::warn(format("Exception when preparing {} tags: {}", enum_name(tagFileType), e.what()));
         }
-        _tagFileNeedUpdateMap[tagFileType] = false;
+    }
+
+    try {
+        if (_configUseBuiltinTagExtractor.load()) {
+            vector<bool> isExtracted(updates.size());
+            for (size_t index = 0; index < updates.size(); ++index) {
+                if (isExtracted[index]) {
+                    continue;
+                }
+                vector<TagExtractor::Output> outputs;
+                for (auto other = index; other < updates.size(); ++other) {
+                    if (const auto& update = updates[other];
+                        !isExtracted[other] && update.files == updates[index].files) {
+                        outputs.push_back({
+                            _tagKindsMap.at(update.tagFileType),
+                            update.differenceOpt.has_value() ? update.deltaPath : update.tempTagFilePath
+                        });
+                        isExtracted[other] = true;
+                    }
+                }
+                _tagExtractor.extract(updates[index].files, outputs);
+            }
+        } else {
+            for (const auto& update: updates) {
+                if (!update.differenceOpt.has_value()) {
+                    system::runCommand("ctags.exe", format(
+                        R"(--excmd=combine -f "{}" --fields=+e+n --kinds-c={} --languages=C,C++ -R "{}")",
+                        update.tempTagFilePath.generic_string(),
+                        _tagKindsMap.at(update.tagFileType),
+                        rootPath.generic_string()
+                    ));
+                } else if (!update.files.empty()) {
+                    {
+                        auto listStream = ofstream{update.listPath, ios::trunc};
+                        listStream.exceptions(ios_base::badbit | ios_base::failbit);
+                        for (const auto& file: update.files) {
+                            listStream << file << '\n';
+                        }
+                    }
+                    system::runCommand("ctags.exe", format(
+                        R"(--excmd=combine -f "{}" --fields=+e+n --kinds-c={} --languages=C,C++ -L "{}")",
+                        update.deltaPath.generic_string(),
+                        _tagKindsMap.at(update.tagFileType),
+                        update.listPath.generic_string()
+                    ));
+                }
+            }
+        }
+    } catch (exception& e) {
+        logger::warn(format("Exception when extracting tags: {}", e.what()));
+        return;
+    }
+
+    for (const auto& update: updates) {
+        try {
+            if (update.differenceOpt.has_value()) {
+                const auto& [changedFiles, removedFiles] = update.differenceOpt.value();
+                auto excludedFiles = changedFiles;
+                excludedFiles.insert(removedFiles.begin(), removedFiles.end());
+                mergeTagFile(update.tagFilePath, update.deltaPath, excludedFiles, update.tempTagFilePath);
+                error_code errorCode;
+                remove(update.listPath, errorCode);
+                remove(update.deltaPath, errorCode);
+            }
+            auto tagIndex = make_unique<TagIndex>(update.tempTagFilePath); {
+                unique_lock lock{_getTagFileMutex(update.tagFileType)};
+                _tagIndexes[enum_integer(update.tagFileType)].reset();
+                tagIndex->relocate(update.tagFilePath);
+                _tagIndexes[enum_integer(update.tagFileType)] = move(tagIndex);
+                ++_tagGeneration;
+            }
+            update.manifest.save(update.manifestPath);
+        } catch (exception& e) {
+            logger::warn(format("Exception when updating {} tags: {}", enum_name(update.tagFileType), e.what()));
+        }
+    }
+}
+
+void SymbolManager::_watchRootPath(const filesystem::path& rootPath) {
+    {
+        unique_lock lock{_rootPathMutex};
+        if (_fileWatcher && _fileWatcher->alive() && _fileWatcher->rootPath() == rootPath) {
+            return;
+        }
+        if (_fileWatcher && !_fileWatcher->alive()) {
+            logger::info(format("Rescan tags due to dead watcher on '{}'", _fileWatcher->rootPath().generic_string()));
+        }
+        _fileWatcher.reset();
+        try {
+            _fileWatcher = make_unique<FileWatcher>(rootPath, 500ms, [this](unordered_set<string>&& changedFiles) {
+                erase_if(changedFiles, [](const auto& file) {
+                    const auto path = filesystem::path(file);
+                    return path.has_extension() && !TagManifest::isSourceFile(path);
+                });
+                if (changedFiles.empty()) {
+                    return;
+                }
+                unique_lock lock{_tagFileUpdateMutex};
+                for (auto& [tagFileType, dirtyFiles]: _tagFileDirtyFilesMap) {
+                    dirtyFiles.insert(changedFiles.begin(), changedFiles.end());
+                    _scheduleTagFileUpdate(tagFileType);
+                }
+            });
+            logger::info(format("Watching root path: '{}'", rootPath.generic_string()));
+        } catch (exception& e) {
+            logger::warn(format("Exception when watching root path: {}", e.what()));
+        }
+    }
+    unique_lock lock{_tagFileUpdateMutex};
+    for (auto& [tagFileType, needUpdate]: _tagFileNeedUpdateMap) {
+        needUpdate = true;
+        _scheduleTagFileUpdate(tagFileType);
     }
 }
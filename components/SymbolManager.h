@@ -1,10 +1,21 @@
 #pragma once
 
+#include <array>
+#include <semaphore>
+#include <unordered_set>
+
 #include <singleton_dclp.hpp>
 
+#include <models/configs.h>
 #include <models/ReviewReference.h>
 #include <models/SymbolInfo.h>
+#include <types/common.h>
 #include <types/ConstMap.h>
+#include <types/FileWatcher.h>
+#include <types/LruCache.h>
+#include <types/TagExtractor.h>
+#include <types/TagIndex.h>
+#include <types/WorkStealingPool.h>
 
 namespace components {
     class SymbolManager : public SingletonDclp<SymbolManager> {
@@ -21,15 +32,22 @@ namespace components {
         std::unordered_map<std::string, models::ReviewReference> getReviewReferences(
             const std::string& content,
             const std::filesystem::path& referencePath,
-            uint32_t targetDepth = 0
+            uint32_t targetDepth = 0,
+            types::Time deadline = types::Time::max(),
+            uint32_t maxReferenceCount = 256,
+            uint64_t maxReferenceBytes = 1024 * 1024
         ) const;
 
+        std::pair<uint64_t, uint64_t> getSymbolCacheStatistics() const;
+
         std::vector<models::SymbolInfo> getSymbols(
             const std::string& content,
             const std::filesystem::path& referencePath,
             bool full = false
         ) const;
 
+        void updateGenericConfig(const models::GenericConfig& genericConfig);
+
         void updateRootPath(const std::filesystem::path& currentFilePath);
 
     private:
@@ -49,24 +67,59 @@ namespace components {
                 }
             }
         };
+        const types::EnumMap<TagFileType, std::tuple<const char *, const char *, const char *>>
+        _tagIncrementFilenameMap = {
+            {
+                {
+                    {TagFileType::Function, {"function.files", "function.list", "function.delta"}},
+                    {TagFileType::Structure, {"structure.files", "structure.list", "structure.delta"}}
+                }
+            }
+        };
         std::unordered_map<TagFileType, bool> _tagFileNeedUpdateMap = {
             {TagFileType::Function, false},
-            {TagFileType::Function, false}
+            {TagFileType::Structure, false}
         };
         mutable std::shared_mutex _rootPathMutex, _functionTagFileMutex, _structureTagFileMutex;
-        std::atomic<bool> _isRunning{true}, _functionTagFileNeedUpdate{false}, _structureTagFileNeedUpdate{false};
+        std::unordered_map<TagFileType, bool> _tagFileUpdatingMap = {
+            {TagFileType::Function, false},
+            {TagFileType::Structure, false}
+        };
+        std::mutex _tagFileUpdateMutex;
+        std::unordered_map<TagFileType, std::unordered_set<std::string>> _tagFileDirtyFilesMap = {
+            {TagFileType::Function, {}},
+            {TagFileType::Structure, {}}
+        };
+        std::atomic<bool> _configUseBuiltinTagExtractor{false}, _isRunning{true},
+                _functionTagFileNeedUpdate{false}, _structureTagFileNeedUpdate{false};
         std::filesystem::path _rootPath;
+        mutable std::atomic<uint64_t> _symbolCacheHitCount{0}, _symbolCacheMissCount{0}, _tagGeneration{0};
+        mutable std::counting_semaphore<> _referenceReadSemaphore{8};
+        mutable std::mutex _symbolCacheMutex;
+        mutable types::LruCache<uint64_t, std::vector<models::SymbolInfo>> _symbolCache{64};
+        mutable std::array<std::unique_ptr<types::TagIndex>, magic_enum::enum_count<TagFileType>()> _tagIndexes;
+        const types::WorkStealingPool _referencePool{std::max(std::thread::hardware_concurrency(), 2u)};
+        const types::WorkStealingPool _tagExtractorPool{std::max(std::thread::hardware_concurrency() / 2, 1u)};
+        const types::TagExtractor _tagExtractor{_tagExtractorPool};
+        const types::WorkStealingPool _updatePool{2};
+        std::unique_ptr<types::FileWatcher> _fileWatcher;
 
-        std::unordered_map<std::string, models::ReviewReference> _getReferences(
+        std::vector<models::SymbolInfo> _getSymbols(
             const std::string& content,
             const std::filesystem::path& referencePath,
-            uint32_t depth
+            bool full
         ) const;
 
-        void _threadUpdateFunctionTagFile();
+        std::shared_mutex& _getTagFileMutex(TagFileType tagFileType) const;
+
+        bool _loadTagIndex(TagFileType tagFileType) const;
+
+        std::optional<models::ReviewReference> _readReference(const models::SymbolInfo& symbol, uint32_t depth) const;
+
+        void _scheduleTagFileUpdate(TagFileType tagFileType);
 
-        void _threadUpdateStructureTagFile();
+        void _updateTagFiles(const std::vector<TagFileType>& tagFileTypes);
 
-        void _updateTagFile(TagFileType tagFileType);
+        void _watchRootPath(const std::filesystem::path& rootPath);
     };
 }
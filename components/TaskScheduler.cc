@@ -0,0 +1,102 @@
+#include <format>
+#include <thread>
+
+#include <components/TaskScheduler.h>
+#include <utils/logger.h>
+
+using namespace components;
+using namespace std;
+using namespace types;
+using namespace utils;
+
+TaskScheduler::Handle::Handle(shared_ptr<atomic<bool>> cancelled): _cancelled(move(cancelled)) {}
+
+void TaskScheduler::Handle::cancel() const {
+    if (_cancelled) {
+        _cancelled->store(true);
+    }
+}
+
+bool TaskScheduler::Handle::active() const {
+    return _cancelled && !_cancelled->load();
+}
+
+TaskScheduler::TaskScheduler(const uint32_t workerCount): _state(make_shared<_State>()) {
+    const auto threadCount = max(workerCount, 1u);
+    for (uint32_t index = 0; index < threadCount; ++index) {
+        thread([state = _state] {
+            state->runWorker();
+        }).detach();
+    }
+
+    logger::info(format("TaskScheduler is initialized with {} workers", threadCount));
+}
+
+TaskScheduler::~TaskScheduler() {
+    decltype(_state->queue) queue; {
+        unique_lock lock{_state->mutex};
+        _state->isRunning.store(false);
+        queue.swap(_state->queue);
+        _state->condition.notify_all();
+    }
+}
+
+TaskScheduler::Handle TaskScheduler::schedule(const chrono::milliseconds delay, Task&& task) {
+    return _enqueue(chrono::high_resolution_clock::now() + delay, chrono::milliseconds::zero(), move(task));
+}
+
+TaskScheduler::Handle TaskScheduler::scheduleEvery(const chrono::milliseconds interval, Task&& task) {
+    return _enqueue(chrono::high_resolution_clock::now(), max(interval, chrono::milliseconds(1)), move(task));
+}
+
+TaskScheduler::Handle TaskScheduler::_enqueue(
+    const Time deadline,
+    const chrono::milliseconds interval,
+    Task&& task
+) {
+    auto entry = make_shared<_Entry>(interval, move(task), make_shared<atomic<bool>>(false));
+    Handle handle(entry->cancelled);
+    unique_lock lock{_state->mutex};
+    if (!_state->isRunning.load()) {
+        handle.cancel();
+        return handle;
+    }
+    const auto iterator = _state->queue.emplace(deadline, move(entry));
+    if (iterator == _state->queue.begin()) {
+        _state->condition.notify_one();
+    }
+    return handle;
+}
+
+void TaskScheduler::_State::runWorker() {
+    unique_lock lock{mutex};
+    while (isRunning.load()) {
+        if (queue.empty()) {
+            condition.wait(lock);
+            continue;
+        }
+        if (const auto deadline = queue.begin()->first;
+            chrono::high_resolution_clock::now() < deadline) {
+            condition.wait_until(lock, deadline);
+            continue;
+        }
+        const auto entry = move(queue.begin()->second);
+        queue.erase(queue.begin());
+        if (entry->cancelled->load()) {
+            continue;
+        }
+        if (!queue.empty()) {
+            condition.notify_one();
+        }
+        lock.unlock();
+        try {
+            entry->task();
+        } catch (const exception& e) {
+            logger::warn(format("(TaskScheduler) Exception: {}", e.what()));
+        }
+        lock.lock();
+        if (entry->interval.count() && isRunning.load() && !entry->cancelled->load()) {
+            queue.emplace(chrono::high_resolution_clock::now() + entry->interval, entry);
+        }
+    }
+}
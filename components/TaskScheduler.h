@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include <singleton_dclp.hpp>
+
+#include <types/common.h>
+
+namespace components {
+    class TaskScheduler : public SingletonDclp<TaskScheduler> {
+    public:
+        using Task = std::function<void()>;
+
+        class Handle {
+        public:
+            Handle() = default;
+
+            void cancel() const;
+
+            [[nodiscard]] bool active() const;
+
+        private:
+            friend class TaskScheduler;
+
+            std::shared_ptr<std::atomic<bool>> _cancelled;
+
+            explicit Handle(std::shared_ptr<std::atomic<bool>> cancelled);
+        };
+
+        explicit TaskScheduler(uint32_t workerCount);
+
+        ~TaskScheduler() override;
+
+        Handle schedule(std::chrono::milliseconds delay, Task&& task);
+
+        Handle scheduleEvery(std::chrono::milliseconds interval, Task&& task);
+
+    private:
+        struct _Entry {
+            std::chrono::milliseconds interval;
+            Task task;
+            std::shared_ptr<std::atomic<bool>> cancelled;
+        };
+
+        struct _State {
+            std::atomic<bool> isRunning{true};
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::multimap<types::Time, std::shared_ptr<_Entry>> queue;
+
+            void runWorker();
+        };
+
+        std::shared_ptr<_State> _state;
+
+        Handle _enqueue(types::Time deadline, std::chrono::milliseconds interval, Task&& task);
+    };
+}
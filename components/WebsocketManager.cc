@@ -1,3 +1,5 @@
+#include <thread>
+
 #include <ixwebsocket/IXNetSystem.h>
 #include <magic_enum/magic_enum.hpp>
 
@@ -6,6 +8,7 @@
 #include <components/MemoryManipulator.h>
 #include <components/WebsocketManager.h>
 #include <utils/logger.h>
+#include <utils/zlib.h>
 
 using namespace components;
 using namespace models;
@@ -15,18 +18,46 @@ using namespace std;
 using namespace types;
 using namespace utils;
 
-WebsocketManager::WebsocketManager(string&& url, const chrono::seconds& pingInterval) {
+namespace {
+    constexpr auto bulkCompressionLevel = 6;
+    constexpr auto cacheAckBatchDelay = 20ms;
+    constexpr auto compressionThreshold = 4096;
+    constexpr auto criticalCompressionLevel = 1;
+
+    bool isBulkAction(const WsAction action) {
+        switch (action) {
+            case WsAction::CompletionEdit:
+            case WsAction::EditorCommit:
+            case WsAction::EditorSelection:
+            case WsAction::EditorState:
+            case WsAction::EditorSwitchFile:
+            case WsAction::EditorSwitchProject:
+            case WsAction::ReviewRequest: {
+                return true;
+            }
+            default: {
+                return false;
+            }
+        }
+    }
+}
+
+WebsocketManager::WebsocketManager(string&& url, const chrono::seconds& pingInterval)
+    : _outbound(make_shared<_Outbound>()) {
     initNetSystem();
     _client.setUrl(url);
     _client.setPingInterval(static_cast<int>(pingInterval.count()));
     _client.setOnMessageCallback([this](const WebSocketMessagePtr& messagePtr) {
         switch (messagePtr->type) {
             case WebSocketMessageType::Message: {
-                _handleEventMessage(messagePtr->str);
+                _handleEventMessage(messagePtr->str, messagePtr->binary);
                 break;
             }
             case WebSocketMessageType::Open: {
                 logger::info("Websocket connection established");
+                _wireFormat.store(WireFormat::Json);
+                _capabilities.store(0);
+                ++_sessionId;
                 const auto interactionLock = InteractionMonitor::GetInstance()->getInteractionLock();
                 send(HandShakeClientMessage(
                     MemoryManipulator::GetInstance()->getCurrentFilePath(),
@@ -63,12 +94,20 @@ WebsocketManager::WebsocketManager(string&& url, const chrono::seconds& pingInte
             }
         }
     });
+    registerAction(WsAction::HandShake, this, &WebsocketManager::wsHandShake);
+    thread(&WebsocketManager::_runSender, this, _outbound).detach();
     _client.start();
 
     logger::info(format("WebsocketManager is initialized with url: {}", url));
 }
 
 WebsocketManager::~WebsocketManager() {
+    {
+        unique_lock lock(_outbound->mutex);
+        _outbound->isRunning.store(false);
+        _outbound->condition.notify_all();
+        _outbound->condition.wait(lock, [this] { return !_outbound->isSending.load(); });
+    }
     _client.disableAutomaticReconnection();
     _client.stop();
     uninitNetSystem();
@@ -79,18 +118,85 @@ void WebsocketManager::close() {
     _client.close();
 }
 
-void WebsocketManager::send(const WsMessage& message) {
-    try {
-        _client.send(message.parse());
-    } catch (exception& e) {
-        logger::warn(e.what());
+bool WebsocketManager::hasCapability(const WsCapability capability) const {
+    return _capabilities.load() & 1u << enum_integer(capability);
+}
+
+void WebsocketManager::send(WsMessage&& message) {
+    unique_lock lock(_outbound->mutex);
+    if (message.action == WsAction::CompletionCache && hasCapability(WsCapability::BatchCacheAck)) {
+        const auto isDelete = static_cast<const CompletionCacheClientMessage&>(message).isDelete;
+        if (_outbound->cacheAckOpt.has_value() && _outbound->cacheAckOpt.value().isDelete == isDelete) {
+            ++_outbound->cacheAckOpt.value().count;
+            return;
+        }
+        _outbound->flushCacheAck();
+        _outbound->cacheAckOpt.emplace(isDelete, 1, chrono::high_resolution_clock::now() + cacheAckBatchDelay);
+    } else if (isBulkAction(message.action)) {
+        if (message.action == WsAction::EditorSelection || message.action == WsAction::EditorState) {
+            if (const auto iterator = ranges::find(_outbound->bulkLane | views::reverse, message.action, [](const auto& pending) {
+                return pending->action;
+            }); iterator != (_outbound->bulkLane | views::reverse).end()) {
+                if (message.action == WsAction::EditorState) {
+                    message.mergeFrom(**iterator);
+                }
+                _outbound->bulkLane.erase(prev(iterator.base()));
+            }
+        }
+        _outbound->bulkLane.push_back(make_unique<WsMessage>(move(message)));
+    } else {
+        _outbound->flushCacheAck();
+        _outbound->criticalLane.push_back(make_unique<WsMessage>(move(message)));
+    }
+    _outbound->condition.notify_one();
+}
+
+uint64_t WebsocketManager::sessionId() const {
+    return _sessionId.load();
+}
+
+void WebsocketManager::wsHandShake(nlohmann::json&& data) {
+    if (data.contains("encoding")) {
+        if (const auto wireFormatOpt = enum_cast<WireFormat>(data["encoding"].get<string>());
+            wireFormatOpt.has_value()) {
+            logger::info(format("Negotiated websocket wire format: {}", enum_name(wireFormatOpt.value())));
+            _wireFormat.store(wireFormatOpt.value());
+        } else {
+            logger::info(format("Unsupported websocket wire format: {}", data["encoding"].get<string>()));
+        }
+    }
+    if (data.contains("capabilities")) {
+        uint32_t capabilities = 0;
+        for (const auto& capabilityString: data["capabilities"]) {
+            if (const auto capabilityOpt = enum_cast<WsCapability>(capabilityString.get<string>());
+                capabilityOpt.has_value()) {
+                logger::info(format("Enable websocket capability: {}", enum_name(capabilityOpt.value())));
+                capabilities |= 1u << enum_integer(capabilityOpt.value());
+            }
+        }
+        _capabilities.store(capabilities);
     }
 }
 
-void WebsocketManager::_handleEventMessage(const string& messageString) {
+void WebsocketManager::_handleEventMessage(const string& messageString, const bool isBinary) {
+    if (isBinary && zlib::isCompressed(messageString)) {
+        try {
+            _handleEventMessage(zlib::decompress(messageString), _wireFormat.load() != WireFormat::Json);
+        } catch (const runtime_error& e) {
+            logger::warn(format("Websocket message is not a valid zlib stream: {}", e.what()));
+        }
+        return;
+    }
     try {
-        if (auto message = nlohmann::json::parse(messageString);
-            message.contains("action")) {
+        nlohmann::json message;
+        if (!isBinary) {
+            message = nlohmann::json::parse(messageString);
+        } else if (_wireFormat.load() == WireFormat::MsgPack) {
+            message = nlohmann::json::from_msgpack(messageString);
+        } else {
+            message = nlohmann::json::from_cbor(messageString);
+        }
+        if (message.contains("action")) {
             if (const auto actionOpt = enum_cast<WsAction>(message["action"].get<string>());
                 actionOpt.has_value()) {
                 logger::debug(format("Receive websocket action: {}", message["action"].get<string>()));
@@ -101,15 +207,77 @@ void WebsocketManager::_handleEventMessage(const string& messageString) {
                 logger::info(format("Invalid websocket message action: {}.", message["action"].get<string>()));
             }
         } else {
-            logger::info(format("Invalid websocket message structure: {}.", messageString));
+            logger::info(format("Invalid websocket message structure: {}.", message.dump()));
         }
     } catch (nlohmann::detail::parse_error& e) {
         logger::error(format(
-            "Websocket message is not a valid JSON.\n"
+            "Websocket message is not a valid {}.\n"
             "\tError: '{}'.\n"
             "\tMessage: '{}'.",
+            isBinary ? enum_name(_wireFormat.load()) : enum_name(WireFormat::Json),
             e.what(),
-            messageString
+            isBinary ? format("<{} bytes>", messageString.size()) : messageString
         ));
     }
 }
+
+void WebsocketManager::_runSender(const shared_ptr<_Outbound> outbound) {
+    unique_lock lock(outbound->mutex);
+    while (outbound->isRunning.load()) {
+        if (outbound->criticalLane.empty() && outbound->cacheAckOpt.has_value() &&
+            chrono::high_resolution_clock::now() >= outbound->cacheAckOpt.value().deadline) {
+            outbound->flushCacheAck();
+        }
+        unique_ptr<WsMessage> message;
+        auto compressionLevel = criticalCompressionLevel;
+        if (!outbound->criticalLane.empty()) {
+            message = move(outbound->criticalLane.front());
+            outbound->criticalLane.pop_front();
+        } else if (!outbound->bulkLane.empty()) {
+            message = move(outbound->bulkLane.front());
+            outbound->bulkLane.pop_front();
+            compressionLevel = bulkCompressionLevel;
+        } else if (outbound->cacheAckOpt.has_value()) {
+            outbound->condition.wait_until(lock, outbound->cacheAckOpt.value().deadline);
+            continue;
+        } else {
+            outbound->condition.wait(lock);
+            continue;
+        }
+        outbound->isSending.store(true);
+        lock.unlock();
+        _sendNow(*message, compressionLevel);
+        message.reset();
+        lock.lock();
+        outbound->isSending.store(false);
+        outbound->condition.notify_all();
+    }
+}
+
+void WebsocketManager::_sendNow(const WsMessage& message, const int compressionLevel) {
+    try {
+        const auto wireFormat = _wireFormat.load();
+        if (const auto& payload = message.parse(wireFormat);
+            payload.size() >= compressionThreshold && hasCapability(WsCapability::Compression)) {
+            _client.sendBinary(zlib::compress(payload, compressionLevel));
+        } else if (wireFormat == WireFormat::Json) {
+            _client.send(payload);
+        } else {
+            _client.sendBinary(payload);
+        }
+    } catch (exception& e) {
+        logger::warn(e.what());
+    }
+}
+
+void WebsocketManager::_Outbound::flushCacheAck() {
+    if (!cacheAckOpt.has_value()) {
+        return;
+    }
+    if (const auto [isDelete, count, deadline] = cacheAckOpt.value(); count > 1) {
+        criticalLane.push_back(make_unique<CompletionCacheClientMessage>(isDelete, count));
+    } else {
+        criticalLane.push_back(make_unique<CompletionCacheClientMessage>(isDelete));
+    }
+    cacheAckOpt.reset();
+}
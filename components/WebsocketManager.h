@@ -1,12 +1,19 @@
 #pragma once
 
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 
 #include <ixwebsocket/IXWebSocket.h>
 #include <nlohmann/json.hpp>
 #include <singleton_dclp.hpp>
 
 #include <models/WsMessage.h>
+#include <types/common.h>
+#include <types/WireFormat.h>
+#include <types/WsCapability.h>
 
 namespace components {
     class WebsocketManager : public SingletonDclp<WebsocketManager> {
@@ -38,12 +45,42 @@ namespace components {
             _handlerMap[action].push_back(std::bind_front(memberFunction, other));
         }
 
-        void send(const models::WsMessage& message);
+        [[nodiscard]] bool hasCapability(types::WsCapability capability) const;
+
+        void send(models::WsMessage&& message);
+
+        [[nodiscard]] uint64_t sessionId() const;
+
+        void wsHandShake(nlohmann::json&& data);
 
     private:
+        struct _CacheAck {
+            bool isDelete;
+            uint32_t count;
+            types::Time deadline;
+        };
+
+        struct _Outbound {
+            std::atomic<bool> isRunning{true}, isSending{false};
+            std::condition_variable condition;
+            std::deque<std::unique_ptr<models::WsMessage>> bulkLane, criticalLane;
+            std::mutex mutex;
+            std::optional<_CacheAck> cacheAckOpt;
+
+            void flushCacheAck();
+        };
+
         ix::WebSocket _client;
+        std::atomic<types::WireFormat> _wireFormat{types::WireFormat::Json};
+        std::atomic<uint32_t> _capabilities{};
+        std::atomic<uint64_t> _sessionId{};
+        std::shared_ptr<_Outbound> _outbound;
         std::unordered_map<types::WsAction, std::vector<Handler>> _handlerMap;
 
-        void _handleEventMessage(const std::string& messageString);
+        void _handleEventMessage(const std::string& messageString, bool isBinary);
+
+        void _runSender(std::shared_ptr<_Outbound> outbound);
+
+        void _sendNow(const models::WsMessage& message, int compressionLevel);
     };
 }
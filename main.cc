@@ -7,6 +7,7 @@
 #include <components/ModuleProxy.h>
 #include <components/StatisticManager.h>
 #include <components/SymbolManager.h>
+#include <components/TaskScheduler.h>
 #include <components/WindowManager.h>
 #include <components/WebsocketManager.h>
 #include <models/WsMessage.h>
@@ -22,9 +23,12 @@ using namespace types;
 using namespace utils;
 
 namespace {
+    constexpr auto reviewReferenceTimeout = 10s;
+
     void initialize() {
         logger::info("Comware Coder Proxy is initializing...");
 
+        TaskScheduler::Construct(4);
         ModuleProxy::Construct();
         ConfigManager::Construct();
         MemoryManipulator::Construct(ConfigManager::GetInstance()->version());
@@ -39,6 +43,7 @@ namespace {
     void finalize() {
         logger::info("Comware Coder Proxy is finalizing...");
 
+        TaskScheduler::Destruct();
         CompletionManager::Destruct();
         StatisticManager::Construct();
         InteractionMonitor::Destruct();
@@ -107,6 +112,11 @@ BOOL __stdcall DllMain(const HMODULE hModule, const DWORD dwReason, [[maybe_unus
                 CompletionManager::GetInstance(),
                 &CompletionManager::interactionSave
             );
+            InteractionMonitor::GetInstance()->registerInteraction(
+                Interaction::SelectionReplace,
+                CompletionManager::GetInstance(),
+                &CompletionManager::interactionSelectionReplace
+            );
             InteractionMonitor::GetInstance()->registerInteraction(
                 Interaction::SelectionReplace,
                 [](const std::any& data, bool&) {
@@ -160,6 +170,7 @@ BOOL __stdcall DllMain(const HMODULE hModule, const DWORD dwReason, [[maybe_unus
                         if (const auto genericConfigOpt = serverMessage.genericConfig();
                             genericConfigOpt.has_value()) {
                             InteractionMonitor::GetInstance()->updateGenericConfig(genericConfigOpt.value());
+                            SymbolManager::GetInstance()->updateGenericConfig(genericConfigOpt.value());
                         }
                         if (const auto shortcutConfigOpt = serverMessage.shortcutConfig();
                             shortcutConfigOpt.has_value()) {
@@ -179,7 +190,10 @@ BOOL __stdcall DllMain(const HMODULE hModule, const DWORD dwReason, [[maybe_unus
                         serverMessage.result == "success") {
                         const auto reviewReferences =
                                 SymbolManager::GetInstance()->getReviewReferences(
-                                    serverMessage.content(), serverMessage.path(), 0
+                                    serverMessage.content(),
+                                    serverMessage.path(),
+                                    0,
+                                    chrono::high_resolution_clock::now() + reviewReferenceTimeout
                                 )
                                 | views::values
                                 | views::filter([&serverMessage](const ReviewReference& reviewReference) {
@@ -1,6 +1,9 @@
+#include <charconv>
+
 #include <magic_enum/magic_enum.hpp>
 
 #include <models/WsMessage.h>
+#include <types/MessageWriter.h>
 #include <utils/base64.h>
 #include <utils/common.h>
 #include <utils/iconv.h>
@@ -18,17 +21,17 @@ WsMessage::WsMessage(const WsAction action): id(common::uuid()), action(action)
 WsMessage::WsMessage(const WsAction action, nlohmann::json&& data)
     : id(common::uuid()), action(action), _data(move(data)) {}
 
-string WsMessage::parse() const {
-    nlohmann::json jsonMessage = {
-        {"id", id},
-        {"action", enum_name(action)},
-    };
-
-    if (!_data.empty()) {
-        jsonMessage["data"] = _data;
+void WsMessage::mergeFrom(const WsMessage& older) {
+    if (_data.is_object() && older._data.is_object()) {
+        auto data = older._data;
+        data.update(_data);
+        _data = move(data);
     }
+}
 
-    return jsonMessage.dump();
+const string& WsMessage::parse(const WireFormat wireFormat) const {
+    thread_local MessageWriter messageWriter;
+    return messageWriter.write(wireFormat, id, enum_name(action), _data);
 }
 
 ChatInsertServerMessage::ChatInsertServerMessage(nlohmann::json&& data)
@@ -53,7 +56,15 @@ CompletionAcceptClientMessage::CompletionAcceptClientMessage(const string& actio
     ) {}
 
 CompletionCacheClientMessage::CompletionCacheClientMessage(const bool isDelete)
-    : WsMessage(WsAction::CompletionCache, isDelete) {}
+    : WsMessage(WsAction::CompletionCache, isDelete), isDelete(isDelete) {}
+
+CompletionCacheClientMessage::CompletionCacheClientMessage(const bool isDelete, const uint32_t count)
+    : WsMessage(
+        WsAction::CompletionCache, {
+            {"count", count},
+            {"isDelete", isDelete},
+        }
+    ), isDelete(isDelete) {}
 
 CompletionCancelClientMessage::CompletionCancelClientMessage(const string& actionId, bool isExplicit)
     : WsMessage(
@@ -77,8 +88,10 @@ CompletionEditClientMessage::CompletionEditClientMessage(
     }
 ) {}
 
-CompletionGenerateClientMessage::CompletionGenerateClientMessage(const CompletionComponents& completionComponents)
-    : WsMessage(WsAction::CompletionGenerate, completionComponents.toJson()) {}
+CompletionGenerateClientMessage::CompletionGenerateClientMessage(
+    const CompletionComponents& completionComponents,
+    const optional<ContextDelta::Delta>& contextDeltaOpt
+): WsMessage(WsAction::CompletionGenerate, completionComponents.toJson(contextDeltaOpt)) {}
 
 CompletionGenerateServerMessage::CompletionGenerateServerMessage(nlohmann::json&& data)
     : WsMessage(WsAction::CompletionGenerate, move(data)), result(_data["result"].get<string>()) {
@@ -107,6 +120,17 @@ CompletionGenerateServerMessage::CompletionGenerateServerMessage(nlohmann::json&
     } else if (_data.contains("message")) {
         _message = _data["message"].get<string>();
     }
+    if (_data.contains("fingerprint")) {
+        const auto& fingerprintString = _data["fingerprint"].get_ref<const string&>();
+        if (uint64_t fingerprint{}; from_chars(
+            fingerprintString.data(),
+            fingerprintString.data() + fingerprintString.size(),
+            fingerprint,
+            16
+        ).ec == errc{}) {
+            _fingerprintOpt.emplace(fingerprint);
+        }
+    }
 }
 
 string CompletionGenerateServerMessage::message() const {
@@ -117,6 +141,18 @@ optional<Completions> CompletionGenerateServerMessage::completions() const {
     return _completionsOpt;
 }
 
+optional<uint64_t> CompletionGenerateServerMessage::fingerprint() const {
+    return _fingerprintOpt;
+}
+
+CompletionReuseClientMessage::CompletionReuseClientMessage(const string& actionId, const string& originalActionId)
+    : WsMessage(
+        WsAction::CompletionReuse, {
+            {"actionId", actionId},
+            {"originalActionId", originalActionId},
+        }
+    ) {}
+
 CompletionSelectClientMessage::CompletionSelectClientMessage(
     const string& actionId,
     const CompletionComponents::GenerateType generateType,
@@ -294,7 +330,15 @@ HandShakeClientMessage::HandShakeClientMessage(
         WsAction::HandShake, {
             {"pid", GetCurrentProcessId()},
             {"currentFile", iconv::autoDecode(currentFile.generic_string())},
+            {
+                "capabilities", nlohmann::json::array({
+                    enum_name(WsCapability::BatchCacheAck),
+                    enum_name(WsCapability::Compression),
+                    enum_name(WsCapability::DeltaContext),
+                })
+            },
             {"currentProject", iconv::autoDecode(currentProject.generic_string())},
+            {"encodings", {enum_name(WireFormat::Cbor), enum_name(WireFormat::MsgPack), enum_name(WireFormat::Json)}},
             {"version", version},
         }
     ) {}
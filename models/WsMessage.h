@@ -8,6 +8,8 @@
 #include <types/CompletionComponents.h>
 #include <types/Completions.h>
 #include <types/Selection.h>
+#include <types/WireFormat.h>
+#include <types/WsCapability.h>
 #include <types/WsAction.h>
 
 namespace models {
@@ -16,7 +18,16 @@ namespace models {
         const std::string id;
         const types::WsAction action;
 
-        [[nodiscard]] std::string parse() const;
+        WsMessage(const WsMessage&) = default;
+
+        WsMessage(WsMessage&&) = default;
+
+        virtual ~WsMessage() = default;
+
+        void mergeFrom(const WsMessage& older);
+
+        // The result is a per-thread buffer that is reused by the next call on the same thread
+        [[nodiscard]] const std::string& parse(types::WireFormat wireFormat = types::WireFormat::Json) const;
 
     protected:
         nlohmann::json _data;
@@ -24,8 +35,6 @@ namespace models {
         explicit WsMessage(types::WsAction action);
 
         WsMessage(types::WsAction action, nlohmann::json&& data);
-
-        virtual ~WsMessage() = default;
     };
 
     class ChatInsertServerMessage final : public WsMessage {
@@ -50,7 +59,11 @@ namespace models {
 
     class CompletionCacheClientMessage final : public WsMessage {
     public:
+        const bool isDelete;
+
         explicit CompletionCacheClientMessage(bool isDelete);
+
+        CompletionCacheClientMessage(bool isDelete, uint32_t count);
     };
 
     class CompletionCancelClientMessage final : public WsMessage {
@@ -77,7 +90,10 @@ namespace models {
 
     class CompletionGenerateClientMessage final : public WsMessage {
     public:
-        explicit CompletionGenerateClientMessage(const types::CompletionComponents& completionComponents);
+        explicit CompletionGenerateClientMessage(
+            const types::CompletionComponents& completionComponents,
+            const std::optional<types::ContextDelta::Delta>& contextDeltaOpt = std::nullopt
+        );
     };
 
     class CompletionGenerateServerMessage : public WsMessage {
@@ -90,9 +106,17 @@ namespace models {
 
         [[nodiscard]] std::optional<types::Completions> completions() const;
 
+        [[nodiscard]] std::optional<uint64_t> fingerprint() const;
+
     private:
         std::string _message;
         std::optional<types::Completions> _completionsOpt{};
+        std::optional<uint64_t> _fingerprintOpt{};
+    };
+
+    class CompletionReuseClientMessage final : public WsMessage {
+    public:
+        CompletionReuseClientMessage(const std::string& actionId, const std::string& originalActionId);
     };
 
     class CompletionSelectClientMessage final : public WsMessage {
@@ -8,6 +8,16 @@ using namespace std;
 using namespace types;
 
 namespace {
+    ContextBudget parseContextBudget(const nlohmann::json& contextBudget) {
+        return {
+            contextBudget.contains("unit")
+                ? enum_cast<ContextBudget::Unit>(contextBudget["unit"].get<string>()).value_or(ContextBudget::Unit::Line)
+                : ContextBudget::Unit::Line,
+            contextBudget.contains("prefix") ? contextBudget["prefix"].get<uint32_t>() : 0,
+            contextBudget.contains("suffix") ? contextBudget["suffix"].get<uint32_t>() : 0,
+        };
+    }
+
     KeyCombination parseShortcutConfig(const nlohmann::json& shortcutConfig) {
         ModifierSet modifiers;
         for (const auto& modifierString: shortcutConfig["modifiers"]) {
@@ -18,10 +28,24 @@ namespace {
         }
         return {shortcutConfig["keycode"].get<uint32_t>(), modifiers};
     }
+
+    TriggerRules parseTriggerRules(const nlohmann::json& triggerRules) {
+        const TriggerRules defaultTriggerRules;
+        return {
+            triggerRules.contains("keywords")
+                ? triggerRules["keywords"].get<vector<string>>()
+                : defaultTriggerRules.keywords(),
+            triggerRules.contains("ignoredCharacters") ? triggerRules["ignoredCharacters"].get<string>() : "{}",
+            triggerRules.contains("keywordCharacters") ? triggerRules["keywordCharacters"].get<string>() : ";",
+        };
+    }
 }
 
 CompletionConfig::CompletionConfig(const nlohmann::json& data)
-    : debounceDelay(
+    : contextBudget(
+          data.contains("contextBudget") ? optional(parseContextBudget(data["contextBudget"])) : nullopt
+      ),
+      debounceDelay(
           data.contains("debounceDelayMilliSeconds")
               ? optional(chrono::milliseconds(data["debounceDelayMilliSeconds"].get<uint32_t>()))
               : nullopt
@@ -39,6 +63,14 @@ CompletionConfig::CompletionConfig(const nlohmann::json& data)
       ),
       suffixLineCount(
           data.contains("suffixLineCount") ? optional(data["suffixLineCount"].get<uint32_t>()) : nullopt
+      ),
+      refreshCachedCompletion(
+          data.contains("refreshCachedCompletion")
+              ? optional(data["refreshCachedCompletion"].get<bool>())
+              : nullopt
+      ),
+      triggerRules(
+          data.contains("triggerRules") ? optional(parseTriggerRules(data["triggerRules"])) : nullopt
       ) {}
 
 GenericConfig::GenericConfig(const nlohmann::json& data)
@@ -51,6 +83,9 @@ GenericConfig::GenericConfig(const nlohmann::json& data)
           data.contains("interactionUnlockDelayMilliSeconds")
               ? optional(chrono::milliseconds(data["interactionUnlockDelayMilliSeconds"].get<uint32_t>()))
               : nullopt
+      ),
+      useBuiltinTagExtractor(
+          data.contains("useBuiltinTagExtractor") ? optional(data["useBuiltinTagExtractor"].get<bool>()) : nullopt
       ) {}
 
 ShortcutConfig::ShortcutConfig(const nlohmann::json& data)
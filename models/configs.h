@@ -3,13 +3,18 @@
 #include <optional>
 #include <nlohmann/json.hpp>
 
+#include <types/ContextBudget.h>
 #include <types/keys.h>
+#include <types/TriggerRules.h>
 
 namespace models {
     class CompletionConfig {
     public:
+        const std::optional<types::ContextBudget> contextBudget;
         const std::optional<std::chrono::milliseconds> debounceDelay;
         const std::optional<uint32_t> pasteFixMaxTriggerLineCount, prefixLineCount, recentFileCount, suffixLineCount;
+        const std::optional<bool> refreshCachedCompletion;
+        const std::optional<types::TriggerRules> triggerRules;
 
         explicit CompletionConfig(const nlohmann::json& data);
     };
@@ -18,6 +23,7 @@ namespace models {
     public:
         const std::optional<std::chrono::seconds> autoSaveInterval;
         const std::optional<std::chrono::milliseconds> interactionUnlockDelay;
+        const std::optional<bool> useBuiltinTagExtractor;
 
         explicit GenericConfig(const nlohmann::json& data);
     };
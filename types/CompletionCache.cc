@@ -1,45 +1,133 @@
+#include <algorithm>
+
 #include <types/CompletionCache.h>
 
 using namespace std;
 using namespace types;
 
+uint32_t CompletionCache::candidateIndex() const {
+    return valid() ? _candidates[_current].index : 0;
+}
+
 optional<pair<char, optional<string>>> CompletionCache::previous() {
     if (!valid()) {
         return nullopt;
     }
 
-    const auto currentChar = _content[_index];
+    const auto currentChar = _content()[_index];
 
     if (_index > 0) {
         --_index;
-        return make_pair(currentChar, _content.substr(_index));
+        _ranges.pop_back();
+        return make_pair(currentChar, _content().substr(_index));
     }
 
     return make_pair(currentChar, nullopt);
 }
 
-optional<pair<char, optional<string>>> CompletionCache::next() {
+optional<pair<char, optional<string>>> CompletionCache::next(const char character) {
     if (!valid()) {
         return nullopt;
     }
 
-    const auto currentChar = _content[_index];
+    if (const auto advancedOpt = _advance(character); !advancedOpt.has_value()) {
+        return make_pair(_content()[_index], nullopt);
+    } else if (advancedOpt.value()) {
+        return make_pair(character, _content().substr(_index));
+    }
+    return make_pair(character, nullopt);
+}
 
-    if (_index < _content.length() - 1) {
-        ++_index;
-        return make_pair(currentChar, _content.substr(_index));
+optional<pair<uint32_t, optional<string>>> CompletionCache::nextLine() {
+    if (!valid()) {
+        return nullopt;
     }
 
-    return make_pair(currentChar, nullopt);
+    uint32_t consumedCount = 0;
+    if (_content().substr(_index, 2) == "\r\n") {
+        if (!_advance('\r').value_or(false)) {
+            return nullopt;
+        }
+        ++consumedCount;
+    }
+    const auto advancedOpt = _advance('\n');
+    if (!advancedOpt.has_value()) {
+        return nullopt;
+    }
+    ++consumedCount;
+    if (!advancedOpt.value()) {
+        return make_pair(consumedCount, nullopt);
+    }
+    while (_content()[_index] == ' ' || _content()[_index] == '\t') {
+        if (!_advance(_content()[_index]).value_or(false)) {
+            return make_pair(consumedCount + 1, nullopt);
+        }
+        ++consumedCount;
+    }
+    return make_pair(consumedCount, _content().substr(_index));
 }
 
-tuple<string, int64_t> CompletionCache::reset(string content) {
-    const auto previousState = make_tuple(_content, _index);
-    _content = move(content);
-    _index = _content.empty() ? -1 : 0;
+tuple<string, int64_t> CompletionCache::reset(const vector<string>& candidates, const uint32_t currentIndex) {
+    auto previousState = make_tuple(valid() ? _content() : string{}, _index);
+    _candidates.clear();
+    _ranges.clear();
+    _current = 0;
+    _index = -1;
+    if (currentIndex < candidates.size() && !candidates[currentIndex].empty()) {
+        _candidates.reserve(candidates.size());
+        for (uint32_t index = 0; index < candidates.size(); ++index) {
+            _candidates.emplace_back(candidates[index], index);
+        }
+        ranges::stable_sort(_candidates, {}, &_Candidate::content);
+        _current = static_cast<size_t>(distance(
+            _candidates.begin(),
+            ranges::find(_candidates, currentIndex, &_Candidate::index)
+        ));
+        _ranges.emplace_back(0, _candidates.size());
+        _index = 0;
+    }
     return previousState;
 }
 
 bool CompletionCache::valid() const {
     return _index >= 0;
 }
+
+optional<bool> CompletionCache::_advance(const char character) {
+    const auto position = static_cast<size_t>(_index);
+    const auto characterKey = [position](const _Candidate& candidate) {
+        return candidate.content.length() > position
+                   ? static_cast<int32_t>(static_cast<unsigned char>(candidate.content[position]))
+                   : -1;
+    };
+    const auto [rangeBegin, rangeEnd] = _ranges.back();
+    const auto [matchBegin, matchEnd] = ranges::equal_range(
+        _candidates.begin() + static_cast<ptrdiff_t>(rangeBegin),
+        _candidates.begin() + static_cast<ptrdiff_t>(rangeEnd),
+        static_cast<int32_t>(static_cast<unsigned char>(character)),
+        {},
+        characterKey
+    );
+    if (matchBegin == matchEnd) {
+        return nullopt;
+    }
+    if (const auto matchFirst = static_cast<size_t>(distance(_candidates.begin(), matchBegin)),
+                   matchLast = static_cast<size_t>(distance(_candidates.begin(), matchEnd));
+        _current < matchFirst || _current >= matchLast) {
+        _current = static_cast<size_t>(distance(
+            _candidates.begin(),
+            ranges::min_element(matchBegin, matchEnd, {}, &_Candidate::index)
+        ));
+    }
+
+    if (_index < _content().length() - 1) {
+        ++_index;
+        _ranges.emplace_back(distance(_candidates.begin(), matchBegin), distance(_candidates.begin(), matchEnd));
+        return true;
+    }
+    return false;
+}
+
+const string& CompletionCache::_content() const {
+    return _candidates[_current].content;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <optional>
+#include <vector>
 
 #include <types/CompletionComponents.h>
 #include <types/Selection.h>
@@ -8,16 +9,31 @@
 namespace types {
     class CompletionCache {
     public:
+        [[nodiscard]] uint32_t candidateIndex() const;
+
         std::optional<std::pair<char, std::optional<std::string>>> previous();
 
-        std::optional<std::pair<char, std::optional<std::string>>> next();
+        std::optional<std::pair<char, std::optional<std::string>>> next(char character);
+
+        std::optional<std::pair<uint32_t, std::optional<std::string>>> nextLine();
 
-        std::tuple<std::string, int64_t> reset(std::string content = {});
+        std::tuple<std::string, int64_t> reset(const std::vector<std::string>& candidates = {}, uint32_t currentIndex = 0);
 
         [[nodiscard]] bool valid() const;
 
     private:
-        std::string _content;
+        struct _Candidate {
+            std::string content;
+            uint32_t index;
+        };
+
+        std::vector<_Candidate> _candidates;
+        std::vector<std::pair<size_t, size_t>> _ranges;
+        size_t _current{};
         int64_t _index = -1;
+
+        std::optional<bool> _advance(char character);
+
+        [[nodiscard]] const std::string& _content() const;
     };
 }
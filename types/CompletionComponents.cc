@@ -1,7 +1,9 @@
+#include <format>
+
 #include <magic_enum/magic_enum.hpp>
 
 #include <types/CompletionComponents.h>
-#include <utils/base64.h>
+#include <utils/common.h>
 #include <utils/iconv.h>
 
 using namespace magic_enum;
@@ -24,6 +26,24 @@ CompletionComponents::CompletionComponents(
     _resetTimePoints();
 }
 
+uint64_t CompletionComponents::fingerprint() const {
+    const auto prefixTail = string_view(_prefix).substr(_prefix.size() - min<size_t>(_prefix.size(), 1024));
+    const auto suffixHead = string_view(_suffix).substr(0, 256);
+    auto result = common::hash(format(
+        "{}\t{}\t{}\t{}\t{}\t{}\t{}",
+        enum_name(_generateType),
+        path.generic_string(),
+        _caretPosition.line,
+        _caretPosition.character,
+        prefixTail.size(),
+        _infix.size(),
+        suffixHead.size()
+    ));
+    result = common::hash(prefixTail, result);
+    result = common::hash(_infix, result);
+    return common::hash(suffixHead, result);
+}
+
 string CompletionComponents::getPrefix() const {
     return _prefix;
 }
@@ -56,14 +76,23 @@ void CompletionComponents::setRecentFiles(const vector<filesystem::path>& recent
     _recentFilesTime = chrono::system_clock::now();
 }
 
+void CompletionComponents::setSimilarSnippets(const vector<SnippetIndex::Snippet>& similarSnippets) {
+    _similarSnippets = similarSnippets;
+    _similarSnippetsTime = chrono::system_clock::now();
+}
+
 void CompletionComponents::setSymbols(const vector<SymbolInfo>& symbols) {
     _symbols = symbols;
     _symbolTime = chrono::system_clock::now();
 }
 
-nlohmann::json CompletionComponents::toJson() const {
+nlohmann::json CompletionComponents::toJson(const optional<ContextDelta::Delta>& contextDeltaOpt) const {
+    const auto encodeContent = [](const string& content) {
+        return nlohmann::json::binary({content.begin(), content.end()});
+    };
     nlohmann::json result = {
         {"type", enum_name(_generateType)},
+        {"fingerprint", format("{:016x}", fingerprint())},
         {
             "caret", {
                 {"character", _caretPosition.character},
@@ -73,26 +102,60 @@ nlohmann::json CompletionComponents::toJson() const {
         {"path", iconv::autoDecode(path.generic_string())},
         {
             "context", {
-                {"infix", base64::to_base64(_infix)},
-                {"prefix", base64::to_base64(_prefix)},
-                {"suffix", base64::to_base64(_suffix)},
+                {"infix", encodeContent(_infix)},
+                {"prefix", encodeContent(_prefix)},
+                {"suffix", encodeContent(_suffix)},
             },
         },
         {"recentFiles", nlohmann::json::array()},
+        {"similarSnippets", nlohmann::json::array()},
         {"symbols", nlohmann::json::array()},
         {
             "times", {
                 {"start", getMilliseconds(_initTime)},
                 {"context", getMilliseconds(_contextTime)},
                 {"recentFiles", getMilliseconds(_recentFilesTime)},
+                {"similarSnippets", getMilliseconds(_similarSnippetsTime)},
                 {"symbol", getMilliseconds(_symbolTime)},
                 {"end", getMilliseconds()},
             }
         }
     };
+    if (contextDeltaOpt.has_value()) {
+        const auto& [id, baseIdOpt, prefixEdits, suffixEdits] = contextDeltaOpt.value();
+        auto& context = result["context"];
+        context["id"] = id;
+        if (baseIdOpt.has_value()) {
+            const auto encodeEdits = [&encodeContent](const vector<ContextDelta::Edit>& edits) {
+                auto encodedEdits = nlohmann::json::array();
+                for (const auto& [startLine, endLine, content]: edits) {
+                    encodedEdits.push_back({
+                        {"content", encodeContent(content)},
+                        {"endLine", endLine},
+                        {"startLine", startLine},
+                    });
+                }
+                return encodedEdits;
+            };
+            context.erase("prefix");
+            context.erase("suffix");
+            context["baseId"] = baseIdOpt.value();
+            context["prefixEdits"] = encodeEdits(prefixEdits);
+            context["suffixEdits"] = encodeEdits(suffixEdits);
+        }
+    }
     for (const auto& recentFile: _recentFiles) {
         result["recentFiles"].push_back(iconv::autoDecode(recentFile.generic_string()));
     }
+    for (const auto& [path, startLine, endLine, content, score]: _similarSnippets) {
+        result["similarSnippets"].push_back({
+            {"content", encodeContent(content)},
+            {"endLine", endLine},
+            {"path", iconv::autoDecode(path.generic_string())},
+            {"score", score},
+            {"startLine", startLine},
+        });
+    }
     for (const auto& [path, name, type, startLine, endLine]: _symbols) {
         result["symbols"].push_back({
             {"endLine", endLine},
@@ -135,5 +198,6 @@ void CompletionComponents::_resetTimePoints() {
     _initTime = currentTime;
     _contextTime = currentTime;
     _recentFilesTime = currentTime;
+    _similarSnippetsTime = currentTime;
     _symbolTime = currentTime;
 }
@@ -6,6 +6,8 @@
 
 #include <models/SymbolInfo.h>
 #include <types/CaretPosition.h>
+#include <types/ContextDelta.h>
+#include <types/SnippetIndex.h>
 
 namespace types {
     class CompletionComponents {
@@ -23,6 +25,8 @@ namespace types {
             const std::filesystem::path& path
         );
 
+        [[nodiscard]] uint64_t fingerprint() const;
+
         [[nodiscard]] std::string getPrefix() const;
 
         [[nodiscard]] std::vector<std::filesystem::path> getRecentFiles() const;
@@ -39,9 +43,13 @@ namespace types {
 
         void setRecentFiles(const std::vector<std::filesystem::path>& recentFiles);
 
+        void setSimilarSnippets(const std::vector<SnippetIndex::Snippet>& similarSnippets);
+
         void setSymbols(const std::vector<models::SymbolInfo>& symbols);
 
-        [[nodiscard]] nlohmann::json toJson() const;
+        [[nodiscard]] nlohmann::json toJson(
+            const std::optional<ContextDelta::Delta>& contextDeltaOpt = std::nullopt
+        ) const;
 
         void updateCaretPosition(const CaretPosition& caretPosition);
 
@@ -56,8 +64,9 @@ namespace types {
         CaretPosition _caretPosition;
         std::string _infix, _prefix, _suffix;
         std::vector<std::filesystem::path> _recentFiles;
+        std::vector<SnippetIndex::Snippet> _similarSnippets;
         std::vector<models::SymbolInfo> _symbols;
-        std::chrono::time_point<std::chrono::system_clock> _initTime, _contextTime, _recentFilesTime, _symbolTime;
+        std::chrono::time_point<std::chrono::system_clock> _initTime, _contextTime, _recentFilesTime, _similarSnippetsTime, _symbolTime;
 
         void _resetTimePoints();
     };
@@ -12,6 +12,10 @@ Completions::Completions(
     const vector<string>& candidates
 ): actionId(move(actionId)), generateType(generateType), selection(selection), _candidates(candidates) {}
 
+const vector<string>& Completions::candidates() const {
+    return _candidates;
+}
+
 tuple<string, uint32_t> Completions::current() const {
     return {_candidates[_currentIndex], _currentIndex};
 }
@@ -33,3 +37,10 @@ tuple<string, uint32_t> Completions::previous() {
     }
     return current();
 }
+
+tuple<string, uint32_t> Completions::select(const uint32_t index) {
+    if (index < _candidates.size()) {
+        _currentIndex = index;
+    }
+    return current();
+}
@@ -20,6 +20,8 @@ namespace types {
             const std::vector<std::string>& candidates
         );
 
+        [[nodiscard]] const std::vector<std::string>& candidates() const;
+
         [[nodiscard]] std::tuple<std::string, uint32_t> current() const;
 
         [[nodiscard]] bool empty() const;
@@ -28,6 +30,8 @@ namespace types {
 
         [[nodiscard]] std::tuple<std::string, uint32_t> previous();
 
+        std::tuple<std::string, uint32_t> select(uint32_t index);
+
     private:
         const std::vector<std::string> _candidates;
         uint32_t _currentIndex{};
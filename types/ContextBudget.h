@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+namespace types {
+    struct ContextBudget {
+        enum class Unit {
+            Byte,
+            Line,
+            Token,
+        };
+
+        Unit unit;
+        uint32_t prefix, suffix;
+    };
+}
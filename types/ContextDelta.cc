@@ -0,0 +1,136 @@
+#include <algorithm>
+
+#include <types/ContextDelta.h>
+
+using namespace std;
+using namespace types;
+
+namespace {
+    constexpr int64_t maxShiftLineCount = 16;
+
+    vector<string_view> splitLines(const string_view content) {
+        vector<string_view> result;
+        for (size_t lineStart = 0;;) {
+            const auto lineEnd = content.find('\n', lineStart);
+            if (lineEnd == string_view::npos) {
+                result.push_back(content.substr(lineStart));
+                break;
+            }
+            result.push_back(content.substr(lineStart, lineEnd - lineStart));
+            lineStart = lineEnd + 1;
+        }
+        return result;
+    }
+
+    string joinLines(const vector<string_view>& lines, const size_t begin, const size_t end) {
+        string result;
+        for (auto index = begin; index < end; ++index) {
+            result.append(lines[index]).append("\n");
+        }
+        return result;
+    }
+
+    size_t editSize(const vector<ContextDelta::Edit>& edits) {
+        size_t result = 0;
+        for (const auto& edit: edits) {
+            result += edit.content.size() + sizeof(edit.startLine) + sizeof(edit.endLine);
+        }
+        return result;
+    }
+}
+
+ContextDelta::Delta ContextDelta::update(
+    const uint64_t sessionId,
+    const filesystem::path& path,
+    const string& prefix,
+    const string& suffix
+) {
+    Delta delta{_nextId++, nullopt, {}, {}};
+    if (_baseIdOpt.has_value() && _sessionId == sessionId && _path == path) {
+        auto prefixEdits = _diff(_prefix, prefix);
+        auto suffixEdits = _diff(_suffix, suffix);
+        if ((editSize(prefixEdits) + editSize(suffixEdits)) * 2 < prefix.size() + suffix.size()) {
+            delta.baseIdOpt = _baseIdOpt;
+            delta.prefixEdits = move(prefixEdits);
+            delta.suffixEdits = move(suffixEdits);
+        }
+    }
+    _baseIdOpt.emplace(delta.id);
+    _sessionId = sessionId;
+    _path = path;
+    _prefix = prefix;
+    _suffix = suffix;
+    return delta;
+}
+
+void ContextDelta::reset() {
+    _baseIdOpt.reset();
+    _path.clear();
+    _prefix.clear();
+    _suffix.clear();
+}
+
+vector<ContextDelta::Edit> ContextDelta::_diff(const string_view previous, const string_view current) {
+    if (previous == current) {
+        return {};
+    }
+    const auto previousLines = splitLines(previous);
+    const auto currentLines = splitLines(current);
+    const auto previousCount = static_cast<int64_t>(previousLines.size());
+    const auto currentCount = static_cast<int64_t>(currentLines.size());
+
+    int64_t offset = 0, matchCount = -1;
+    for (int64_t distance = 0; distance <= maxShiftLineCount; ++distance) {
+        for (const auto candidate: {distance, -distance}) {
+            int64_t candidateMatchCount = 0;
+            for (auto index = max(int64_t{0}, -candidate);
+                 index < currentCount && index + candidate < previousCount; ++index) {
+                candidateMatchCount += previousLines[index + candidate] == currentLines[index];
+            }
+            if (candidateMatchCount > matchCount) {
+                offset = candidate;
+                matchCount = candidateMatchCount;
+            }
+        }
+    }
+
+    vector<Edit> edits;
+    const auto addEdit = [&](const int64_t previousBegin, const int64_t previousEnd,
+                             const int64_t currentBegin, const int64_t currentEnd) {
+        if (previousBegin == previousEnd && currentBegin == currentEnd) {
+            return;
+        }
+        if (!edits.empty() && edits.back().endLine == previousBegin) {
+            edits.back().endLine = static_cast<uint32_t>(previousEnd);
+            edits.back().content.append(joinLines(currentLines, currentBegin, currentEnd));
+        } else {
+            edits.emplace_back(
+                static_cast<uint32_t>(previousBegin),
+                static_cast<uint32_t>(previousEnd),
+                joinLines(currentLines, currentBegin, currentEnd)
+            );
+        }
+    };
+
+    auto currentIndex = max(int64_t{0}, -offset);
+    addEdit(0, max(int64_t{0}, offset), 0, min(currentIndex, currentCount));
+    while (currentIndex < currentCount && currentIndex + offset < previousCount) {
+        if (previousLines[currentIndex + offset] == currentLines[currentIndex]) {
+            ++currentIndex;
+            continue;
+        }
+        const auto mismatchBegin = currentIndex;
+        while (currentIndex < currentCount && currentIndex + offset < previousCount &&
+               previousLines[currentIndex + offset] != currentLines[currentIndex]) {
+            ++currentIndex;
+        }
+        addEdit(mismatchBegin + offset, currentIndex + offset, mismatchBegin, currentIndex);
+    }
+    addEdit(
+        min(currentIndex + offset, previousCount),
+        previousCount,
+        min(currentIndex, currentCount),
+        currentCount
+    );
+    return edits;
+}
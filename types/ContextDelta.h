@@ -0,0 +1,40 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace types {
+    class ContextDelta {
+    public:
+        struct Edit {
+            uint32_t startLine, endLine;
+            std::string content;
+        };
+
+        struct Delta {
+            uint64_t id;
+            std::optional<uint64_t> baseIdOpt;
+            std::vector<Edit> prefixEdits, suffixEdits;
+        };
+
+        Delta update(
+            uint64_t sessionId,
+            const std::filesystem::path& path,
+            const std::string& prefix,
+            const std::string& suffix
+        );
+
+        void reset();
+
+    private:
+        uint64_t _nextId{1}, _sessionId{};
+        std::optional<uint64_t> _baseIdOpt;
+        std::filesystem::path _path;
+        std::string _prefix, _suffix;
+
+        static std::vector<Edit> _diff(std::string_view previous, std::string_view current);
+    };
+}
@@ -0,0 +1,254 @@
+#include <format>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+
+#include <types/FileWatcher.h>
+#include <utils/logger.h>
+
+#ifdef _WIN32
+#include <utils/system.h>
+
+#include <windows.h>
+#else
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace types;
+using namespace utils;
+
+namespace {
+#ifdef _WIN32
+    class WindowsBackend final : public FileWatcher::Backend {
+    public:
+        explicit WindowsBackend(const filesystem::path& rootPath)
+            : _rootPath(rootPath),
+              _directoryHandle(
+                  CreateFileW(
+                      rootPath.c_str(),
+                      FILE_LIST_DIRECTORY,
+                      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                      nullptr,
+                      OPEN_EXISTING,
+                      FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+                      nullptr
+                  ),
+                  CloseHandle
+              ),
+              _eventHandle(CreateEventW(nullptr, TRUE, FALSE, nullptr), CloseHandle),
+              _buffer(64 * 1024) {
+            if (_directoryHandle.get() == INVALID_HANDLE_VALUE || !_eventHandle) {
+                throw runtime_error(format(
+                    "Failed to watch '{}': {}",
+                    rootPath.generic_string(),
+                    utils::system::formatSystemMessage(static_cast<long>(GetLastError()))
+                ));
+            }
+            _overlapped.hEvent = _eventHandle.get();
+            _readChanges();
+        }
+
+        ~WindowsBackend() override {
+            CancelIoEx(_directoryHandle.get(), &_overlapped);
+            DWORD bytesTransferred;
+            GetOverlappedResult(_directoryHandle.get(), &_overlapped, &bytesTransferred, TRUE);
+        }
+
+        bool poll(vector<string>& changedFiles, const chrono::milliseconds timeout) override {
+            if (WaitForSingleObject(_eventHandle.get(), static_cast<DWORD>(timeout.count())) != WAIT_OBJECT_0) {
+                return true;
+            }
+            DWORD bytesTransferred{};
+            if (!GetOverlappedResult(_directoryHandle.get(), &_overlapped, &bytesTransferred, FALSE)) {
+                return false;
+            }
+            if (!bytesTransferred) {
+                changedFiles.push_back(_rootPath.generic_string());
+            } else {
+                auto offset = size_t{};
+                while (true) {
+                    const auto information = reinterpret_cast<const FILE_NOTIFY_INFORMATION *>(
+                        reinterpret_cast<const char *>(_buffer.data()) + offset
+                    );
+                    changedFiles.push_back((_rootPath / wstring(
+                        information->FileName, information->FileNameLength / sizeof(WCHAR)
+                    )).lexically_normal().generic_string());
+                    if (!information->NextEntryOffset) {
+                        break;
+                    }
+                    offset += information->NextEntryOffset;
+                }
+            }
+            return _readChanges();
+        }
+
+    private:
+        filesystem::path _rootPath;
+        shared_ptr<void> _directoryHandle, _eventHandle;
+        OVERLAPPED _overlapped{};
+        vector<DWORD> _buffer;
+
+        bool _readChanges() {
+            ResetEvent(_eventHandle.get());
+            return ReadDirectoryChangesW(
+                _directoryHandle.get(),
+                _buffer.data(),
+                static_cast<DWORD>(_buffer.size() * sizeof(DWORD)),
+                TRUE,
+                FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
+                FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE,
+                nullptr,
+                &_overlapped,
+                nullptr
+            );
+        }
+    };
+#else
+    class InotifyBackend final : public FileWatcher::Backend {
+    public:
+        explicit InotifyBackend(const filesystem::path& rootPath)
+            : _rootPath(rootPath), _descriptor(inotify_init1(IN_NONBLOCK | IN_CLOEXEC)), _buffer(64 * 1024) {
+            if (_descriptor < 0) {
+                throw runtime_error(format("Failed to watch '{}'", rootPath.generic_string()));
+            }
+            _addWatches(rootPath);
+        }
+
+        ~InotifyBackend() override {
+            close(_descriptor);
+        }
+
+        bool poll(vector<string>& changedFiles, const chrono::milliseconds timeout) override {
+            pollfd descriptor{_descriptor, POLLIN, 0};
+            if (::poll(&descriptor, 1, static_cast<int>(timeout.count())) <= 0) {
+                return true;
+            }
+            const auto length = read(_descriptor, _buffer.data(), _buffer.size());
+            if (length <= 0) {
+                return true;
+            }
+            for (auto offset = size_t{}; offset < static_cast<size_t>(length);) {
+                const auto event = reinterpret_cast<const inotify_event *>(_buffer.data() + offset);
+                offset += sizeof(inotify_event) + event->len;
+                if (event->mask & IN_Q_OVERFLOW) {
+                    changedFiles.push_back(_rootPath.generic_string());
+                    continue;
+                }
+                const auto iterator = _watchPaths.find(event->wd);
+                if (iterator == _watchPaths.end() || !event->len) {
+                    continue;
+                }
+                const auto path = (iterator->second / event->name).lexically_normal();
+                if ((event->mask & IN_ISDIR) && (event->mask & (IN_CREATE | IN_MOVED_TO))) {
+                    _addWatches(path);
+                }
+                changedFiles.push_back(path.generic_string());
+            }
+            return true;
+        }
+
+    private:
+        filesystem::path _rootPath;
+        int _descriptor;
+        vector<char> _buffer;
+        unordered_map<int, filesystem::path> _watchPaths;
+
+        void _addWatches(const filesystem::path& directory) {
+            _addWatch(directory);
+            const filesystem::recursive_directory_iterator end;
+            error_code errorCode;
+            auto iterator = filesystem::recursive_directory_iterator(
+                directory, filesystem::directory_options::skip_permission_denied, errorCode
+            );
+            while (!errorCode && iterator != end) {
+                if (iterator->is_directory(errorCode)) {
+                    _addWatch(iterator->path());
+                }
+                errorCode.clear();
+                iterator.increment(errorCode);
+                if (errorCode && iterator != end) {
+                    logger::warn(format(
+                        "(FileWatcher) Skip directory '{}': {}", iterator->path().generic_string(), errorCode.message()
+                    ));
+                    errorCode.clear();
+                    iterator.disable_recursion_pending();
+                    iterator.increment(errorCode);
+                }
+            }
+        }
+
+        void _addWatch(const filesystem::path& directory) {
+            if (const auto watchDescriptor = inotify_add_watch(
+                _descriptor,
+                directory.c_str(),
+                IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MODIFY | IN_MOVED_FROM | IN_MOVED_TO
+            ); watchDescriptor >= 0) {
+                _watchPaths.insert_or_assign(watchDescriptor, directory);
+            }
+        }
+    };
+#endif
+}
+
+unique_ptr<FileWatcher::Backend> FileWatcher::Backend::create(const filesystem::path& rootPath) {
+#ifdef _WIN32
+    return make_unique<WindowsBackend>(rootPath);
+#else
+    return make_unique<InotifyBackend>(rootPath);
+#endif
+}
+
+FileWatcher::FileWatcher(
+    const filesystem::path& rootPath,
+    const chrono::milliseconds quietPeriod,
+    Callback&& callback
+): _rootPath(rootPath), _isAlive(make_shared<atomic<bool>>(true)), _isRunning(make_shared<atomic<bool>>(true)) {
+    thread([
+        isAlive = _isAlive,
+        isRunning = _isRunning,
+        backend = Backend::create(rootPath),
+        rootPath = rootPath.generic_string(),
+        quietPeriod,
+        callback = move(callback)
+    ] {
+        unordered_set<string> pendingFiles;
+        auto lastChangeTime = chrono::steady_clock::now();
+        vector<string> changedFiles;
+        while (isRunning->load()) {
+            try {
+                changedFiles.clear();
+                if (!backend->poll(changedFiles, chrono::milliseconds(100))) {
+                    logger::warn(format("(FileWatcher) Stop watching '{}' due to backend failure", rootPath));
+                    break;
+                }
+                if (!changedFiles.empty()) {
+                    pendingFiles.insert(changedFiles.begin(), changedFiles.end());
+                    lastChangeTime = chrono::steady_clock::now();
+                } else if (!pendingFiles.empty() && chrono::steady_clock::now() - lastChangeTime >= quietPeriod &&
+                           isRunning->load()) {
+                    callback(move(pendingFiles));
+                    pendingFiles.clear();
+                }
+            } catch (const exception& e) {
+                logger::warn(format("(FileWatcher) Exception: {}", e.what()));
+                pendingFiles.clear();
+            }
+        }
+        isAlive->store(false);
+    }).detach();
+}
+
+FileWatcher::~FileWatcher() {
+    _isRunning->store(false);
+}
+
+bool FileWatcher::alive() const {
+    return _isAlive->load();
+}
+
+const filesystem::path& FileWatcher::rootPath() const {
+    return _rootPath;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace types {
+    class FileWatcher {
+    public:
+        using Callback = std::function<void(std::unordered_set<std::string>&& changedFiles)>;
+
+        class Backend {
+        public:
+            virtual ~Backend() = default;
+
+            virtual bool poll(std::vector<std::string>& changedFiles, std::chrono::milliseconds timeout) = 0;
+
+            static std::unique_ptr<Backend> create(const std::filesystem::path& rootPath);
+        };
+
+        FileWatcher(const std::filesystem::path& rootPath, std::chrono::milliseconds quietPeriod, Callback&& callback);
+
+        ~FileWatcher();
+
+        [[nodiscard]] bool alive() const;
+
+        [[nodiscard]] const std::filesystem::path& rootPath() const;
+
+    private:
+        std::filesystem::path _rootPath;
+        std::shared_ptr<std::atomic<bool>> _isAlive, _isRunning;
+    };
+}
@@ -0,0 +1,38 @@
+#include <types/LineCache.h>
+
+using namespace std;
+using namespace types;
+
+void LineCache::clear() {
+    _lines.clear();
+    _lineCountOpt.reset();
+}
+
+optional<string> LineCache::get(const uint32_t line) const {
+    if (const auto iterator = _lines.find(line);
+        iterator != _lines.end()) {
+        return iterator->second;
+    }
+    return nullopt;
+}
+
+void LineCache::invalidate(const uint32_t line) {
+    _lines.erase(line);
+}
+
+void LineCache::invalidateFrom(const uint32_t line) {
+    _lines.erase(_lines.lower_bound(line), _lines.end());
+    _lineCountOpt.reset();
+}
+
+void LineCache::put(const uint32_t line, string content) {
+    _lines.insert_or_assign(line, move(content));
+}
+
+void LineCache::validate(const uint32_t fileHandle, const uint32_t lineCount) {
+    if (fileHandle != _fileHandle || (_lineCountOpt.has_value() && _lineCountOpt.value() != lineCount)) {
+        _lines.clear();
+    }
+    _fileHandle = fileHandle;
+    _lineCountOpt.emplace(lineCount);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <map>
+#include <optional>
+#include <string>
+
+namespace types {
+    class LineCache {
+    public:
+        void clear();
+
+        [[nodiscard]] std::optional<std::string> get(uint32_t line) const;
+
+        void invalidate(uint32_t line);
+
+        void invalidateFrom(uint32_t line);
+
+        void put(uint32_t line, std::string content);
+
+        void validate(uint32_t fileHandle, uint32_t lineCount);
+
+    private:
+        uint32_t _fileHandle{};
+        std::optional<uint32_t> _lineCountOpt;
+        std::map<uint32_t, std::string> _lines;
+    };
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+namespace types {
+    template<typename Key, typename Value, typename Hash = std::hash<Key>>
+    class LruCache {
+    public:
+        explicit LruCache(const size_t capacity): _capacity(std::max<size_t>(capacity, 1)) {}
+
+        void clear() {
+            _itemMap.clear();
+            _items.clear();
+        }
+
+        [[nodiscard]] std::optional<Value> get(const Key& key) {
+            const auto iterator = _itemMap.find(key);
+            if (iterator == _itemMap.end()) {
+                return std::nullopt;
+            }
+            _items.splice(_items.begin(), _items, iterator->second);
+            return iterator->second->second;
+        }
+
+        void put(const Key& key, Value value) {
+            if (const auto iterator = _itemMap.find(key);
+                iterator != _itemMap.end()) {
+                iterator->second->second = std::move(value);
+                _items.splice(_items.begin(), _items, iterator->second);
+                return;
+            }
+            _items.emplace_front(key, std::move(value));
+            _itemMap.emplace(key, _items.begin());
+            while (_items.size() > _capacity) {
+                _itemMap.erase(_items.back().first);
+                _items.pop_back();
+            }
+        }
+
+        [[nodiscard]] size_t size() const {
+            return _items.size();
+        }
+
+    private:
+        size_t _capacity;
+        std::list<std::pair<Key, Value>> _items;
+        std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator, Hash> _itemMap;
+    };
+}
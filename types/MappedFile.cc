@@ -0,0 +1,78 @@
+#include <format>
+#include <stdexcept>
+
+#include <types/MappedFile.h>
+#include <utils/system.h>
+
+#include <windows.h>
+
+using namespace std;
+using namespace types;
+using namespace utils;
+
+MappedFile::MappedFile(const filesystem::path& path) {
+    const shared_ptr<void> fileHandle(
+        CreateFileW(
+            path.c_str(),
+            GENERIC_READ,
+            FILE_SHARE_READ | FILE_SHARE_DELETE,
+            nullptr,
+            OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL,
+            nullptr
+        ),
+        CloseHandle
+    );
+    if (fileHandle.get() == INVALID_HANDLE_VALUE) {
+        throw runtime_error(format(
+            "Failed to open '{}': {}",
+            path.generic_string(),
+            system::formatSystemMessage(static_cast<long>(GetLastError()))
+        ));
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle.get(), &fileSize)) {
+        throw runtime_error(format(
+            "Failed to get size of '{}': {}",
+            path.generic_string(),
+            system::formatSystemMessage(static_cast<long>(GetLastError()))
+        ));
+    }
+    _size = static_cast<size_t>(fileSize.QuadPart);
+    if (!_size) {
+        return;
+    }
+
+    const shared_ptr<void> mappingHandle(
+        CreateFileMapping(fileHandle.get(), nullptr, PAGE_READONLY, 0, 0, nullptr),
+        CloseHandle
+    );
+    if (!mappingHandle) {
+        throw runtime_error(format(
+            "Failed to create mapping of '{}': {}",
+            path.generic_string(),
+            system::formatSystemMessage(static_cast<long>(GetLastError()))
+        ));
+    }
+
+    _view = shared_ptr<void>(MapViewOfFile(mappingHandle.get(), FILE_MAP_READ, 0, 0, 0), UnmapViewOfFile);
+    if (!_view) {
+        throw runtime_error(format(
+            "Failed to map view of '{}': {}",
+            path.generic_string(),
+            system::formatSystemMessage(static_cast<long>(GetLastError()))
+        ));
+    }
+}
+
+string_view MappedFile::content() const {
+    if (!_view) {
+        return {};
+    }
+    return {static_cast<const char *>(_view.get()), _size};
+}
+
+size_t MappedFile::size() const {
+    return _size;
+}
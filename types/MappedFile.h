@@ -0,0 +1,20 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <string_view>
+
+namespace types {
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::filesystem::path& path);
+
+        [[nodiscard]] std::string_view content() const;
+
+        [[nodiscard]] size_t size() const;
+
+    private:
+        std::shared_ptr<void> _view;
+        size_t _size{};
+    };
+}
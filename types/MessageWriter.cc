@@ -0,0 +1,224 @@
+#include <charconv>
+#include <cmath>
+#include <format>
+
+#include <types/MessageWriter.h>
+#include <utils/base64.h>
+
+using namespace std;
+using namespace types;
+
+namespace {
+    constexpr auto hexDigits = "0123456789abcdef";
+
+    size_t utf8SequenceLength(const string_view value, const size_t index) {
+        const auto leadByte = static_cast<unsigned char>(value[index]);
+        const size_t length = leadByte > 0xF4 ? 0 : leadByte >= 0xF0 ? 4 : leadByte >= 0xE0 ? 3
+                                                      : leadByte >= 0xC2 ? 2 : 0;
+        if (!length || index + length > value.size()) {
+            return 0;
+        }
+        const auto secondByte = static_cast<unsigned char>(value[index + 1]);
+        const unsigned char secondMin = leadByte == 0xE0 ? 0xA0 : leadByte == 0xF0 ? 0x90 : 0x80;
+        const unsigned char secondMax = leadByte == 0xED ? 0x9F : leadByte == 0xF4 ? 0x8F : 0xBF;
+        if (secondByte < secondMin || secondByte > secondMax) {
+            return 0;
+        }
+        for (size_t offset = 2; offset < length; ++offset) {
+            if ((static_cast<unsigned char>(value[index + offset]) & 0xC0) != 0x80) {
+                return 0;
+            }
+        }
+        return length;
+    }
+}
+
+const string& MessageWriter::write(
+    const WireFormat wireFormat,
+    const string_view id,
+    const string_view action,
+    const nlohmann::json& data
+) {
+    _buffer.clear();
+    const auto hasData = !data.empty();
+    if (wireFormat == WireFormat::Json) {
+        _buffer.append(R"({"id":)");
+        _writeString(id);
+        _buffer.append(R"(,"action":)");
+        _writeString(action);
+        if (hasData) {
+            _buffer.append(R"(,"data":)");
+            _writeJson(data);
+        }
+        _buffer.push_back('}');
+        return _buffer;
+    }
+
+    const auto append = [this, wireFormat](const nlohmann::json& value) {
+        if (wireFormat == WireFormat::Cbor) {
+            nlohmann::json::to_cbor(value, _buffer);
+        } else {
+            nlohmann::json::to_msgpack(value, _buffer);
+        }
+    };
+    _buffer.push_back(static_cast<char>((wireFormat == WireFormat::Cbor ? 0xA0 : 0x80) | (hasData ? 3 : 2)));
+    append("id");
+    append(id);
+    append("action");
+    append(action);
+    if (hasData) {
+        append("data");
+        append(data);
+    }
+    return _buffer;
+}
+
+void MessageWriter::_writeBase64(const nlohmann::json::binary_t& bytes) {
+    _buffer.push_back('"');
+    const auto offset = _buffer.size();
+    _buffer.resize(offset + (bytes.size() + 2) / 3 * 4, '=');
+    auto output = _buffer.data() + offset;
+    size_t index = 0;
+    for (; index + 3 <= bytes.size(); index += 3) {
+        const auto t1 = bytes[index], t2 = bytes[index + 1], t3 = bytes[index + 2];
+        *output++ = base64::detail::encode_table_0[t1];
+        *output++ = base64::detail::encode_table_1[((t1 & 0x03) << 4) | ((t2 >> 4) & 0x0F)];
+        *output++ = base64::detail::encode_table_1[((t2 & 0x0F) << 2) | ((t3 >> 6) & 0x03)];
+        *output++ = base64::detail::encode_table_1[t3];
+    }
+    if (bytes.size() - index == 1) {
+        const auto t1 = bytes[index];
+        *output++ = base64::detail::encode_table_0[t1];
+        *output = base64::detail::encode_table_1[(t1 & 0x03) << 4];
+    } else if (bytes.size() - index == 2) {
+        const auto t1 = bytes[index], t2 = bytes[index + 1];
+        *output++ = base64::detail::encode_table_0[t1];
+        *output++ = base64::detail::encode_table_1[((t1 & 0x03) << 4) | ((t2 >> 4) & 0x0F)];
+        *output = base64::detail::encode_table_1[(t2 & 0x0F) << 2];
+    }
+    _buffer.push_back('"');
+}
+
+void MessageWriter::_writeJson(const nlohmann::json& value) {
+    char number[32];
+    switch (value.type()) {
+        case nlohmann::json::value_t::boolean: {
+            _buffer.append(value.get<bool>() ? "true" : "false");
+            break;
+        }
+        case nlohmann::json::value_t::number_integer: {
+            const auto [pointer, errorCode] = to_chars(number, number + sizeof(number), value.get<int64_t>());
+            _buffer.append(number, pointer);
+            break;
+        }
+        case nlohmann::json::value_t::number_unsigned: {
+            const auto [pointer, errorCode] = to_chars(number, number + sizeof(number), value.get<uint64_t>());
+            _buffer.append(number, pointer);
+            break;
+        }
+        case nlohmann::json::value_t::number_float: {
+            if (const auto floatValue = value.get<double>(); isfinite(floatValue)) {
+                const auto [pointer, errorCode] = to_chars(number, number + sizeof(number), floatValue);
+                _buffer.append(number, pointer);
+            } else {
+                _buffer.append("null");
+            }
+            break;
+        }
+        case nlohmann::json::value_t::string: {
+            _writeString(value.get_ref<const string&>());
+            break;
+        }
+        case nlohmann::json::value_t::binary: {
+            _writeBase64(value.get_binary());
+            break;
+        }
+        case nlohmann::json::value_t::array: {
+            _buffer.push_back('[');
+            for (auto iterator = value.begin(); iterator != value.end(); ++iterator) {
+                if (iterator != value.begin()) {
+                    _buffer.push_back(',');
+                }
+                _writeJson(*iterator);
+            }
+            _buffer.push_back(']');
+            break;
+        }
+        case nlohmann::json::value_t::object: {
+            _buffer.push_back('{');
+            for (auto iterator = value.begin(); iterator != value.end(); ++iterator) {
+                if (iterator != value.begin()) {
+                    _buffer.push_back(',');
+                }
+                _writeString(iterator.key());
+                _buffer.push_back(':');
+                _writeJson(iterator.value());
+            }
+            _buffer.push_back('}');
+            break;
+        }
+        default: {
+            _buffer.append("null");
+            break;
+        }
+    }
+}
+
+void MessageWriter::_writeString(const string_view value) {
+    _buffer.push_back('"');
+    size_t runStart = 0;
+    for (size_t index = 0; index < value.size(); ++index) {
+        const auto character = static_cast<unsigned char>(value[index]);
+        if (character >= 0x80) {
+            const auto length = utf8SequenceLength(value, index);
+            if (!length) {
+                throw runtime_error(format("Invalid UTF-8 byte at index {}: 0x{:02X}", index, character));
+            }
+            index += length - 1;
+            continue;
+        }
+        if (character >= 0x20 && character != '"' && character != '\\') {
+            continue;
+        }
+        _buffer.append(value.substr(runStart, index - runStart));
+        switch (character) {
+            case '"': {
+                _buffer.append(R"(\")");
+                break;
+            }
+            case '\\': {
+                _buffer.append(R"(\\)");
+                break;
+            }
+            case '\b': {
+                _buffer.append(R"(\b)");
+                break;
+            }
+            case '\f': {
+                _buffer.append(R"(\f)");
+                break;
+            }
+            case '\n': {
+                _buffer.append(R"(\n)");
+                break;
+            }
+            case '\r': {
+                _buffer.append(R"(\r)");
+                break;
+            }
+            case '\t': {
+                _buffer.append(R"(\t)");
+                break;
+            }
+            default: {
+                _buffer.append(R"(\u00)");
+                _buffer.push_back(hexDigits[character >> 4]);
+                _buffer.push_back(hexDigits[character & 0x0F]);
+                break;
+            }
+        }
+        runStart = index + 1;
+    }
+    _buffer.append(value.substr(runStart));
+    _buffer.push_back('"');
+}
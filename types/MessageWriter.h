@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include <nlohmann/json.hpp>
+
+#include <types/WireFormat.h>
+
+namespace types {
+    class MessageWriter {
+    public:
+        const std::string& write(
+            WireFormat wireFormat,
+            std::string_view id,
+            std::string_view action,
+            const nlohmann::json& data
+        );
+
+    private:
+        std::string _buffer;
+
+        void _writeBase64(const nlohmann::json::binary_t& bytes);
+
+        void _writeJson(const nlohmann::json& value);
+
+        void _writeString(std::string_view value);
+    };
+}
@@ -0,0 +1,195 @@
+#include <algorithm>
+#include <cctype>
+
+#include <types/SnippetIndex.h>
+#include <utils/common.h>
+#include <utils/fs.h>
+#include <utils/iconv.h>
+
+using namespace std;
+using namespace types;
+using namespace utils;
+
+SnippetIndex::SnippetIndex(const uint32_t windowLineCount, const uint32_t windowStride)
+    : _windowLineCount(max(windowLineCount, 1u)), _windowStride(max(windowStride, 1u)) {}
+
+vector<SnippetIndex::Snippet> SnippetIndex::query(
+    const string_view context,
+    const filesystem::path& excludedPath,
+    const uint32_t count,
+    const chrono::microseconds timeBudget
+) const {
+    const auto deadline = chrono::steady_clock::now() + timeBudget;
+    auto contextStart = context.size();
+    for (uint32_t lineCount = 0; contextStart > 0 && lineCount < _windowLineCount; ++lineCount) {
+        const auto lineStart = context.rfind('\n', contextStart - 1);
+        contextStart = lineStart == string_view::npos ? 0 : lineStart;
+    }
+    const auto contextTokens = _tokenize(context.substr(contextStart));
+    if (contextTokens.empty() || !count) {
+        return {};
+    }
+
+    vector<pair<string, shared_ptr<const _File>>> files; {
+        shared_lock lock(_filesMutex);
+        const auto excludedKey = excludedPath.generic_string();
+        for (const auto& [key, file]: _files) {
+            if (key != excludedKey) {
+                files.emplace_back(key, file);
+            }
+        }
+    }
+
+    struct Candidate {
+        double score;
+        size_t fileIndex;
+        const _Window* window;
+    };
+    vector<Candidate> candidates;
+    uint32_t visitedCount = 0;
+    bool isExpired = false;
+    for (size_t fileIndex = 0; fileIndex < files.size() && !isExpired; ++fileIndex) {
+        for (const auto& window: files[fileIndex].second->windows) {
+            if (++visitedCount % 64 == 0 && chrono::steady_clock::now() > deadline) {
+                isExpired = true;
+                break;
+            }
+            size_t intersection = 0;
+            for (auto left = contextTokens.begin(), right = window.tokens.begin();
+                 left != contextTokens.end() && right != window.tokens.end();) {
+                if (*left < *right) {
+                    ++left;
+                } else if (*right < *left) {
+                    ++right;
+                } else {
+                    ++intersection;
+                    ++left;
+                    ++right;
+                }
+            }
+            if (intersection) {
+                candidates.emplace_back(
+                    static_cast<double>(intersection) /
+                    static_cast<double>(contextTokens.size() + window.tokens.size() - intersection),
+                    fileIndex,
+                    &window
+                );
+            }
+        }
+    }
+    ranges::sort(candidates, ranges::greater{}, &Candidate::score);
+
+    vector<Snippet> result;
+    for (const auto& [score, fileIndex, window]: candidates) {
+        if (result.size() >= count) {
+            break;
+        }
+        const auto& [key, file] = files[fileIndex];
+        if (ranges::any_of(result, [&key, window](const Snippet& snippet) {
+            return snippet.path == key && snippet.startLine < window->endLine &&
+                   window->startLine < snippet.endLine;
+        })) {
+            continue;
+        }
+        string content;
+        for (auto line = window->startLine; line < window->endLine; ++line) {
+            content.append(file->lines[line]).append("\n");
+        }
+        result.emplace_back(key, window->startLine, window->endLine, iconv::autoDecode(content), score);
+    }
+    return result;
+}
+
+void SnippetIndex::retain(const vector<filesystem::path>& paths) {
+    vector<string> keys;
+    keys.reserve(paths.size());
+    for (const auto& path: paths) {
+        keys.push_back(path.generic_string());
+    }
+    unique_lock lock(_filesMutex);
+    erase_if(_files, [&keys](const auto& item) {
+        return ranges::find(keys, item.first) == keys.end();
+    });
+}
+
+void SnippetIndex::update(const filesystem::path& path) {
+    const auto key = path.generic_string();
+    error_code errorCode;
+    const auto lastWriteTime = filesystem::last_write_time(path, errorCode);
+    if (errorCode) {
+        unique_lock lock(_filesMutex);
+        _files.erase(key);
+        return;
+    } {
+        shared_lock lock(_filesMutex);
+        if (const auto iterator = _files.find(key);
+            iterator != _files.end() && iterator->second->lastWriteTime == lastWriteTime) {
+            return;
+        }
+    }
+
+    auto file = make_shared<_File>();
+    file->lastWriteTime = lastWriteTime;
+    const auto content = fs::readFile(key);
+    for (size_t lineStart = 0; lineStart < content.size();) {
+        auto lineEnd = content.find('\n', lineStart);
+        if (lineEnd == string::npos) {
+            lineEnd = content.size();
+        }
+        auto line = string_view(content).substr(lineStart, lineEnd - lineStart);
+        if (line.ends_with('\r')) {
+            line.remove_suffix(1);
+        }
+        file->lines.emplace_back(line);
+        lineStart = lineEnd + 1;
+    }
+
+    vector<vector<uint64_t>> lineTokens;
+    lineTokens.reserve(file->lines.size());
+    for (const auto& line: file->lines) {
+        lineTokens.push_back(_tokenize(line));
+    }
+    const auto lineCount = static_cast<uint32_t>(file->lines.size());
+    for (uint32_t startLine = 0; startLine < lineCount; startLine += _windowStride) {
+        const auto endLine = min(startLine + _windowLineCount, lineCount);
+        _Window window{startLine, endLine, {}};
+        for (auto line = startLine; line < endLine; ++line) {
+            window.tokens.insert(window.tokens.end(), lineTokens[line].begin(), lineTokens[line].end());
+        }
+        ranges::sort(window.tokens);
+        const auto [first, last] = ranges::unique(window.tokens);
+        window.tokens.erase(first, last);
+        if (!window.tokens.empty()) {
+            file->windows.push_back(move(window));
+        }
+        if (endLine == lineCount) {
+            break;
+        }
+    }
+
+    unique_lock lock(_filesMutex);
+    _files.insert_or_assign(key, move(file));
+}
+
+vector<uint64_t> SnippetIndex::_tokenize(const string_view content) {
+    vector<uint64_t> result;
+    for (size_t index = 0; index < content.size();) {
+        if (const auto character = static_cast<unsigned char>(content[index]);
+            !isalpha(character) && character != '_') {
+            ++index;
+            continue;
+        }
+        const auto tokenStart = index;
+        while (index < content.size() &&
+               (isalnum(static_cast<unsigned char>(content[index])) || content[index] == '_')) {
+            ++index;
+        }
+        if (index - tokenStart > 1) {
+            result.push_back(common::hash(content.substr(tokenStart, index - tokenStart)));
+        }
+    }
+    ranges::sort(result);
+    const auto [first, last] = ranges::unique(result);
+    result.erase(first, last);
+    return result;
+}
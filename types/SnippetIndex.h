@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace types {
+    class SnippetIndex {
+    public:
+        struct Snippet {
+            std::filesystem::path path;
+            uint32_t startLine, endLine;
+            std::string content;
+            double score;
+        };
+
+        explicit SnippetIndex(uint32_t windowLineCount = 20, uint32_t windowStride = 10);
+
+        [[nodiscard]] std::vector<Snippet> query(
+            std::string_view context,
+            const std::filesystem::path& excludedPath,
+            uint32_t count,
+            std::chrono::microseconds timeBudget
+        ) const;
+
+        void retain(const std::vector<std::filesystem::path>& paths);
+
+        void update(const std::filesystem::path& path);
+
+    private:
+        struct _Window {
+            uint32_t startLine, endLine;
+            std::vector<uint64_t> tokens;
+        };
+
+        struct _File {
+            std::filesystem::file_time_type lastWriteTime;
+            std::vector<std::string> lines;
+            std::vector<_Window> windows;
+        };
+
+        const uint32_t _windowLineCount, _windowStride;
+        mutable std::shared_mutex _filesMutex;
+        std::unordered_map<std::string, std::shared_ptr<const _File>> _files;
+
+        static std::vector<uint64_t> _tokenize(std::string_view content);
+    };
+}
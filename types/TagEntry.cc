@@ -1,8 +1,49 @@
+#include <charconv>
+
 #include <types/TagEntry.h>
 
 using namespace std;
 using namespace types;
 
+namespace {
+    string_view nextField(string_view& line) {
+        const auto offset = line.find('\t');
+        const auto field = line.substr(0, offset);
+        line.remove_prefix(offset == string_view::npos ? line.size() : offset + 1);
+        return field;
+    }
+
+    string unescape(const string_view value) {
+        string result;
+        result.reserve(value.size());
+        for (size_t index = 0; index < value.size(); ++index) {
+            if (value[index] == '\\' && index + 1 < value.size()) {
+                switch (value[++index]) {
+                    case 't': {
+                        result.push_back('\t');
+                        break;
+                    }
+                    case 'r': {
+                        result.push_back('\r');
+                        break;
+                    }
+                    case 'n': {
+                        result.push_back('\n');
+                        break;
+                    }
+                    default: {
+                        result.push_back(value[index]);
+                        break;
+                    }
+                }
+            } else {
+                result.push_back(value[index]);
+            }
+        }
+        return result;
+    }
+}
+
 TagEntry::TagEntry(const tagEntry& entry)
     : fileScope(entry.fileScope),
       name(entry.name),
@@ -14,6 +55,54 @@ TagEntry::TagEntry(const tagEntry& entry)
     }
 }
 
+TagEntry::TagEntry(string_view line): fileScope(false), address({{}, 0}) {
+    if (const auto lineEnd = line.find_first_of("\r\n");
+        lineEnd != string_view::npos) {
+        line = line.substr(0, lineEnd);
+    }
+    name = nextField(line);
+    file = nextField(line);
+
+    auto command = line;
+    if (const auto commandEnd = line.find(";\"\t");
+        commandEnd != string_view::npos) {
+        command = line.substr(0, commandEnd);
+        line.remove_prefix(commandEnd + 3);
+    } else {
+        if (command.ends_with(";\"")) {
+            command.remove_suffix(2);
+        }
+        line = {};
+    }
+    if (const auto [pointer, error] = from_chars(command.data(), command.data() + command.size(), address.lineNumber);
+        error == errc{} && pointer != command.data()) {
+        command.remove_prefix(pointer - command.data());
+        if (command.starts_with(';')) {
+            command.remove_prefix(1);
+        }
+    }
+    address.pattern = command;
+
+    while (!line.empty()) {
+        const auto field = nextField(line);
+        const auto separator = field.find(':');
+        if (separator == string_view::npos) {
+            kind = field;
+            continue;
+        }
+        const auto key = field.substr(0, separator);
+        const auto value = field.substr(separator + 1);
+        if (key == "kind") {
+            kind = value;
+        } else if (key == "file") {
+            fileScope = true;
+        } else if (key == "line") {
+            from_chars(value.data(), value.data() + value.size(), address.lineNumber);
+        } else {
+            fields.insert_or_assign(string(key), unescape(value));
+        }
+    }
+}
 
 optional<uint32_t> TagEntry::getEndLine() const {
     if (const auto key = "end";
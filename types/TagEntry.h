@@ -2,6 +2,7 @@
 
 #include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 #include <readtags.h>
@@ -21,6 +22,8 @@ namespace types {
 
         explicit TagEntry(const tagEntry& entry);
 
+        explicit TagEntry(std::string_view line);
+
         [[nodiscard]] std::optional<uint32_t> getEndLine() const;
 
         [[nodiscard]] std::optional<std::string> getEnumTarget() const;
@@ -0,0 +1,595 @@
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <unordered_set>
+
+#include <types/TagExtractor.h>
+
+using namespace std;
+using namespace types;
+
+namespace {
+    enum class TokenType {
+        Character,
+        Identifier,
+        Number,
+        Punctuation,
+        String,
+    };
+
+    struct Token {
+        TokenType type;
+        string_view text;
+        uint32_t line;
+
+        [[nodiscard]] bool is(const char punctuation) const {
+            return type == TokenType::Punctuation && text.front() == punctuation;
+        }
+
+        [[nodiscard]] bool is(const string_view identifier) const {
+            return type == TokenType::Identifier && text == identifier;
+        }
+    };
+
+    struct Tag {
+        char kind;
+        string name;
+        uint32_t line;
+        optional<uint32_t> endLine;
+        bool fileScope;
+        string field;
+    };
+
+    struct Conditional {
+        bool taken, skipping, disabled;
+    };
+
+    const unordered_set<string_view> reservedWords{
+        "__asm__", "__attribute__", "__declspec", "asm", "auto", "break", "case", "char", "const", "continue",
+        "default", "do", "double", "else", "enum", "extern", "float", "for", "goto", "if", "inline", "int", "long",
+        "register", "return", "short", "signed", "sizeof", "static", "struct", "switch", "typedef", "union",
+        "unsigned", "void", "volatile", "while",
+    };
+
+    bool isIdentifierStart(const char character) {
+        return isalpha(static_cast<unsigned char>(character)) || character == '_' || character == '$' ||
+               static_cast<unsigned char>(character) >= 0x80;
+    }
+
+    bool isIdentifierCharacter(const char character) {
+        return isIdentifierStart(character) || isdigit(static_cast<unsigned char>(character));
+    }
+
+    class Parser {
+    public:
+        Parser(const string_view content, const string_view file): _content(content), _file(file) {
+            _lineOffsets.push_back(0);
+            for (size_t offset = 0; offset < content.size(); ++offset) {
+                if (content[offset] == '\n') {
+                    _lineOffsets.push_back(offset + 1);
+                }
+            }
+        }
+
+        vector<Tag> parse() {
+            _tokenize();
+            size_t index = 0;
+            while (index < _tokens.size()) {
+                _parseStatement(index);
+            }
+            return move(_tags);
+        }
+
+        [[nodiscard]] string_view getLine(const uint32_t line) const {
+            const auto begin = _lineOffsets[line - 1];
+            auto text = _content.substr(begin, line < _lineOffsets.size() ? _lineOffsets[line] - begin : string_view::npos);
+            while (!text.empty() && (text.back() == '\n' || text.back() == '\r')) {
+                text.remove_suffix(1);
+            }
+            return text;
+        }
+
+    private:
+        string_view _content, _file;
+        vector<size_t> _lineOffsets;
+        vector<Token> _tokens;
+        vector<Tag> _tags;
+
+        [[nodiscard]] string _anonymousName(const uint32_t line) const {
+            return format("__anon{:x}", hash<string>{}(format("{}:{}:{}", _file, line, _tags.size())));
+        }
+
+        void _tokenize() {
+            vector<Conditional> conditionals;
+            const auto isSkipping = [&conditionals] {
+                return !conditionals.empty() && conditionals.back().skipping;
+            };
+            const auto isDisabled = [&conditionals] {
+                return !conditionals.empty() && conditionals.back().disabled;
+            };
+            uint32_t line = 1;
+            bool isLineStart = true;
+            size_t offset = 0;
+            const auto size = _content.size();
+            const auto skipBlockComment = [&] {
+                offset += 2;
+                while (offset < size && !(_content[offset] == '*' && offset + 1 < size && _content[offset + 1] == '/')) {
+                    if (_content[offset++] == '\n') {
+                        ++line;
+                    }
+                }
+                offset = min(offset + 2, size);
+            };
+            const auto skipLiteral = [&](const char quote) {
+                ++offset;
+                while (offset < size && _content[offset] != quote && _content[offset] != '\n') {
+                    if (_content[offset] == '\\' && offset + 1 < size) {
+                        if (_content[++offset] == '\n') {
+                            ++line;
+                        }
+                    }
+                    ++offset;
+                }
+                if (offset < size && _content[offset] == quote) {
+                    ++offset;
+                }
+            };
+
+            while (offset < size) {
+                const auto character = _content[offset];
+                if (character == '\n') {
+                    ++line;
+                    ++offset;
+                    isLineStart = true;
+                    continue;
+                }
+                if (isspace(static_cast<unsigned char>(character))) {
+                    ++offset;
+                    continue;
+                }
+                if (character == '/' && offset + 1 < size && _content[offset + 1] == '/') {
+                    while (offset < size && _content[offset] != '\n') {
+                        ++offset;
+                    }
+                    continue;
+                }
+                if (character == '/' && offset + 1 < size && _content[offset + 1] == '*') {
+                    skipBlockComment();
+                    continue;
+                }
+                if (character == '#' && isLineStart) {
+                    ++offset;
+                    while (offset < size && (_content[offset] == ' ' || _content[offset] == '\t')) {
+                        ++offset;
+                    }
+                    const auto directiveBegin = offset;
+                    while (offset < size && isIdentifierCharacter(_content[offset])) {
+                        ++offset;
+                    }
+                    const auto directive = _content.substr(directiveBegin, offset - directiveBegin);
+                    const auto argumentBegin = offset;
+                    optional<pair<string_view, uint32_t>> macroOpt;
+                    if (directive == "define" && !isDisabled()) {
+                        while (offset < size && (_content[offset] == ' ' || _content[offset] == '\t')) {
+                            ++offset;
+                        }
+                        const auto nameBegin = offset;
+                        while (offset < size && isIdentifierCharacter(_content[offset])) {
+                            ++offset;
+                        }
+                        if (offset > nameBegin && isIdentifierStart(_content[nameBegin])) {
+                            macroOpt.emplace(_content.substr(nameBegin, offset - nameBegin), line);
+                        }
+                    }
+                    while (offset < size && _content[offset] != '\n') {
+                        if (_content[offset] == '\\' && offset + 1 < size &&
+                            (_content[offset + 1] == '\n' ||
+                             (_content[offset + 1] == '\r' && offset + 2 < size && _content[offset + 2] == '\n'))) {
+                            offset += _content[offset + 1] == '\r' ? 3 : 2;
+                            ++line;
+                        } else if (_content[offset] == '/' && offset + 1 < size && _content[offset + 1] == '*') {
+                            skipBlockComment();
+                        } else if (_content[offset] == '/' && offset + 1 < size && _content[offset + 1] == '/') {
+                            while (offset < size && _content[offset] != '\n') {
+                                ++offset;
+                            }
+                        } else {
+                            ++offset;
+                        }
+                    }
+                    if (macroOpt.has_value()) {
+                        const auto [name, macroLine] = macroOpt.value();
+                        _tags.push_back({'d', string(name), macroLine, line, false, {}});
+                    }
+
+                    auto argument = _content.substr(argumentBegin, offset - argumentBegin);
+                    while (!argument.empty() && isspace(static_cast<unsigned char>(argument.front()))) {
+                        argument.remove_prefix(1);
+                    }
+                    const auto isZero = argument.starts_with('0') &&
+                                        (argument.size() == 1 || !isIdentifierCharacter(argument[1]));
+                    const auto parentSkipping = conditionals.size() > 1 && conditionals[conditionals.size() - 2].skipping;
+                    const auto parentDisabled = conditionals.size() > 1 && conditionals[conditionals.size() - 2].disabled;
+                    if (directive == "if" || directive == "ifdef" || directive == "ifndef") {
+                        const auto outerSkipping = isSkipping(), outerDisabled = isDisabled();
+                        const auto disabled = directive == "if" && isZero;
+                        conditionals.push_back({!disabled, outerSkipping || disabled, outerDisabled || disabled});
+                    } else if ((directive == "elif" || directive == "else") && !conditionals.empty()) {
+                        auto& conditional = conditionals.back();
+                        const auto disabled = directive == "elif" && isZero;
+                        if (conditional.taken) {
+                            conditional.skipping = true;
+                            conditional.disabled = parentDisabled;
+                        } else {
+                            conditional.taken = !disabled;
+                            conditional.skipping = parentSkipping || disabled;
+                            conditional.disabled = parentDisabled || disabled;
+                        }
+                    } else if (directive == "endif" && !conditionals.empty()) {
+                        conditionals.pop_back();
+                    }
+                    continue;
+                }
+                isLineStart = false;
+                const auto tokenBegin = offset;
+                const auto tokenLine = line;
+                TokenType type;
+                if (isIdentifierStart(character)) {
+                    while (offset < size && isIdentifierCharacter(_content[offset])) {
+                        ++offset;
+                    }
+                    type = TokenType::Identifier;
+                    if (offset < size && (_content[offset] == '"' || _content[offset] == '\'') &&
+                        offset - tokenBegin <= 2) {
+                        const auto quote = _content[offset];
+                        skipLiteral(quote);
+                        type = quote == '"' ? TokenType::String : TokenType::Character;
+                    }
+                } else if (isdigit(static_cast<unsigned char>(character))) {
+                    while (offset < size && (isIdentifierCharacter(_content[offset]) || _content[offset] == '.')) {
+                        ++offset;
+                    }
+                    type = TokenType::Number;
+                } else if (character == '"' || character == '\'') {
+                    skipLiteral(character);
+                    type = character == '"' ? TokenType::String : TokenType::Character;
+                } else {
+                    ++offset;
+                    type = TokenType::Punctuation;
+                }
+                if (!isSkipping()) {
+                    _tokens.push_back({type, _content.substr(tokenBegin, offset - tokenBegin), tokenLine});
+                }
+            }
+        }
+
+        size_t _skipBalanced(size_t index) const {
+            const auto open = _tokens[index].text.front();
+            const auto close = open == '{' ? '}' : open == '(' ? ')' : ']';
+            uint32_t depth = 0;
+            for (; index < _tokens.size(); ++index) {
+                if (_tokens[index].is(open)) {
+                    ++depth;
+                } else if (_tokens[index].is(close) && --depth == 0) {
+                    return index + 1;
+                }
+            }
+            return _tokens.size();
+        }
+
+        static optional<string_view> _findDeclaratorName(const span<const Token> declarator) {
+            for (size_t index = 0; index < declarator.size(); ++index) {
+                if (declarator[index].is('(')) {
+                    optional<string_view> nameOpt;
+                    for (auto inner = index + 1; inner < declarator.size() && !declarator[inner].is(')'); ++inner) {
+                        if (declarator[inner].type == TokenType::Identifier &&
+                            !reservedWords.contains(declarator[inner].text)) {
+                            nameOpt = declarator[inner].text;
+                        } else if (declarator[inner].is('(')) {
+                            break;
+                        }
+                    }
+                    if (nameOpt.has_value() && index + 1 < declarator.size() && declarator[index + 1].is('*')) {
+                        return nameOpt;
+                    }
+                    break;
+                }
+            }
+            optional<string_view> nameOpt;
+            for (const auto& token: declarator) {
+                if (token.is('[') || token.is('=') || token.is(':') || token.is('(')) {
+                    break;
+                }
+                if (token.type == TokenType::Identifier && !reservedWords.contains(token.text)) {
+                    nameOpt = token.text;
+                }
+            }
+            return nameOpt;
+        }
+
+        const Token* _findToken(const span<const Token> tokens, const string_view name) const {
+            for (const auto& token: tokens) {
+                if (token.is(name)) {
+                    return &token;
+                }
+            }
+            return nullptr;
+        }
+
+        vector<span<const Token>> _splitDeclarators(const span<const Token> tokens) const {
+            vector<span<const Token>> result;
+            size_t begin = 0;
+            uint32_t depth = 0;
+            for (size_t index = 0; index < tokens.size(); ++index) {
+                if (tokens[index].is('(') || tokens[index].is('[') || tokens[index].is('{')) {
+                    ++depth;
+                } else if ((tokens[index].is(')') || tokens[index].is(']') || tokens[index].is('}')) && depth) {
+                    --depth;
+                } else if (tokens[index].is(',') && depth == 0) {
+                    result.push_back(tokens.subspan(begin, index - begin));
+                    begin = index + 1;
+                }
+            }
+            result.push_back(tokens.subspan(begin));
+            return result;
+        }
+
+        void _parseStatement(size_t& index) {
+            const auto begin = index;
+            optional<pair<string, string_view>> aggregateOpt;
+            size_t declaratorBegin = begin;
+            while (index < _tokens.size()) {
+                const auto& token = _tokens[index];
+                if (token.is(';')) {
+                    _parseDeclaration(
+                        span(_tokens).subspan(begin, index - begin), aggregateOpt, declaratorBegin - begin, token.line
+                    );
+                    ++index;
+                    return;
+                }
+                if (token.is('}')) {
+                    ++index;
+                    return;
+                }
+                if (token.is('(') || token.is('[')) {
+                    index = _skipBalanced(index);
+                    continue;
+                }
+                if (!token.is('{')) {
+                    ++index;
+                    continue;
+                }
+
+                const auto statement = span(_tokens).subspan(begin, index - begin);
+                if (statement.empty() ||
+                    (statement.size() == 2 && statement[0].is("extern") && statement[1].type == TokenType::String) ||
+                    statement[0].is("namespace")) {
+                    ++index;
+                    return;
+                }
+                if (aggregateOpt.has_value() || ranges::any_of(statement, [](const Token& item) {
+                    return item.is('=');
+                })) {
+                    index = _skipBalanced(index);
+                    continue;
+                }
+                if (const auto keywordIterator = ranges::find_if(statement, [](const Token& item) {
+                    return item.is("struct") || item.is("union") || item.is("enum");
+                }); keywordIterator != statement.end() && ranges::none_of(keywordIterator, statement.end(), [](const Token& item) {
+                    return item.is('(');
+                })) {
+                    const auto& keyword = *keywordIterator;
+                    const auto nameIterator = ranges::find_if(keywordIterator + 1, statement.end(), [](const Token& item) {
+                        return item.type != TokenType::Identifier || !reservedWords.contains(item.text);
+                    });
+                    const auto kind = keyword.is("struct") ? 's' : keyword.is("union") ? 'u' : 'g';
+                    const auto isAnonymous = nameIterator == statement.end() ||
+                                             nameIterator->type != TokenType::Identifier;
+                    const auto aggregateName = isAnonymous ? _anonymousName(keyword.line) : string(nameIterator->text);
+                    const auto bodyEnd = _skipBalanced(index);
+                    _tags.push_back({
+                        kind, aggregateName, isAnonymous ? keyword.line : nameIterator->line,
+                        _tokens[bodyEnd - 1].line, false, {}
+                    });
+                    if (kind == 'g' && bodyEnd > index + 1) {
+                        _parseEnumerators(
+                            span(_tokens).subspan(index + 1, bodyEnd - index - (_tokens[bodyEnd - 1].is('}') ? 2 : 1)),
+                            aggregateName
+                        );
+                    }
+                    aggregateOpt.emplace(aggregateName, keyword.text);
+                    index = bodyEnd;
+                    declaratorBegin = bodyEnd;
+                    continue;
+                }
+
+                optional<Token> nameOpt;
+                uint32_t depth = 0;
+                for (size_t inner = 0; inner < statement.size(); ++inner) {
+                    if (statement[inner].is('(')) {
+                        if (depth++ == 0 && inner > 0 && statement[inner - 1].type == TokenType::Identifier &&
+                            !reservedWords.contains(statement[inner - 1].text)) {
+                            nameOpt = statement[inner - 1];
+                        }
+                    } else if (statement[inner].is(')') && depth) {
+                        --depth;
+                    }
+                }
+                const auto bodyEnd = _skipBalanced(index);
+                if (nameOpt.has_value()) {
+                    _tags.push_back({
+                        'f', string(nameOpt->text), nameOpt->line, _tokens[bodyEnd - 1].line,
+                        _findToken(statement, "static") != nullptr, {}
+                    });
+                }
+                index = bodyEnd;
+                return;
+            }
+        }
+
+        void _parseEnumerators(const span<const Token> body, const string& enumName) {
+            for (const auto& enumerator: _splitDeclarators(body)) {
+                if (!enumerator.empty() && enumerator.front().type == TokenType::Identifier) {
+                    _tags.push_back({
+                        'e', string(enumerator.front().text), enumerator.front().line, nullopt, false,
+                        format("enum:{}", enumName)
+                    });
+                }
+            }
+        }
+
+        void _parseDeclaration(
+            const span<const Token> statement,
+            const optional<pair<string, string_view>>& aggregateOpt,
+            const size_t declaratorOffset,
+            const uint32_t endLine
+        ) {
+            if (statement.empty()) {
+                return;
+            }
+            const auto isTypedef = statement.front().is("typedef");
+            if (!isTypedef && (statement.front().is("extern") || statement.front().is("using") ||
+                               statement.front().is("template"))) {
+                return;
+            }
+            const auto isStatic = _findToken(statement, "static") != nullptr;
+
+            auto declarators = _splitDeclarators(statement.subspan(declaratorOffset));
+            string typeReference;
+            if (aggregateOpt.has_value()) {
+                typeReference = format("typeref:{}:{}", aggregateOpt->second, aggregateOpt->first);
+            } else if (const auto keywordIterator = ranges::find_if(statement, [](const Token& item) {
+                return item.is("struct") || item.is("union") || item.is("enum");
+            }); keywordIterator != statement.end() && keywordIterator + 1 != statement.end() &&
+                (keywordIterator + 1)->type == TokenType::Identifier) {
+                typeReference = format("typeref:{}:{}", keywordIterator->text, (keywordIterator + 1)->text);
+            }
+
+            for (size_t declaratorIndex = 0; declaratorIndex < declarators.size(); ++declaratorIndex) {
+                const auto& declarator = declarators[declaratorIndex];
+                if (declarator.empty()) {
+                    continue;
+                }
+                if (!isTypedef) {
+                    if (!aggregateOpt.has_value() && declaratorIndex == 0 && declarator.size() < 2) {
+                        return;
+                    }
+                    if (const auto parenthesis = ranges::find_if(declarator, [](const Token& item) {
+                        return item.is('(');
+                    }); parenthesis != declarator.end() && !(parenthesis + 1 != declarator.end() && (parenthesis + 1)->is('*'))) {
+                        return;
+                    }
+                }
+                const auto nameOpt = _findDeclaratorName(declarator);
+                if (!nameOpt.has_value()) {
+                    continue;
+                }
+                const auto nameToken = ranges::find_if(declarator, [&nameOpt](const Token& item) {
+                    return item.type == TokenType::Identifier && item.text == nameOpt.value();
+                });
+                string field;
+                if (isTypedef) {
+                    if (!typeReference.empty()) {
+                        field = typeReference;
+                    } else {
+                        string typeName;
+                        for (const auto& token: declarators.front()) {
+                            if (token.text == nameOpt.value() || token.is('(') || token.is('[')) {
+                                break;
+                            }
+                            if (!token.is("typedef")) {
+                                typeName.append(typeName.empty() ? "" : " ").append(token.text);
+                            }
+                        }
+                        field = format("typeref:typename:{}", typeName);
+                    }
+                }
+                _tags.push_back({
+                    isTypedef ? 't' : 'v', string(nameOpt.value()), nameToken->line, endLine, isStatic, move(field)
+                });
+            }
+        }
+    };
+
+    string escapePattern(const string_view line) {
+        string result;
+        result.reserve(line.size() + 8);
+        for (const auto character: line) {
+            if (character == '\\' || character == '/') {
+                result.push_back('\\');
+            }
+            result.push_back(character);
+        }
+        return result;
+    }
+
+    string readSourceFile(const string& file) {
+        auto stream = ifstream{filesystem::path(file), ios::binary};
+        stream.exceptions(ios_base::badbit);
+        return {istreambuf_iterator(stream), istreambuf_iterator<char>()};
+    }
+}
+
+TagExtractor::TagExtractor(const WorkStealingPool& pool): _pool(pool) {}
+
+void TagExtractor::extract(const vector<string>& files, const vector<Output>& outputs) const {
+    vector<ofstream> outputStreams;
+    vector<string_view> kindsList;
+    for (const auto& [kinds, path]: outputs) {
+        auto& outputStream = outputStreams.emplace_back(path, ios::binary | ios::trunc);
+        outputStream.exceptions(ios_base::badbit | ios_base::failbit);
+        outputStream << "!_TAG_FILE_FORMAT\t2\t/extended format; --format=1 will not append ;\" to lines/\n"
+                << "!_TAG_FILE_SORTED\t0\t/0=unsorted, 1=sorted, 2=foldcase/\n"
+                << "!_TAG_PROGRAM_NAME\tcmw-coder-proxy\t//\n";
+        kindsList.emplace_back(kinds);
+    }
+
+    mutex outputMutex; {
+        const WorkStealingPool::TaskGroup taskGroup(_pool);
+        for (const auto& file: files) {
+            taskGroup.submit([&file, &kindsList, &outputStreams, &outputMutex] {
+                const auto chunks = parse(readSourceFile(file), file, kindsList);
+                unique_lock lock{outputMutex};
+                for (size_t index = 0; index < chunks.size(); ++index) {
+                    outputStreams[index] << chunks[index];
+                }
+            });
+        }
+        taskGroup.wait();
+    }
+}
+
+vector<string> TagExtractor::parse(
+    const string_view content,
+    const string_view file,
+    const vector<string_view>& kindsList
+) {
+    Parser parser(content, file);
+    const auto tags = parser.parse();
+    vector<string> result(kindsList.size());
+    for (const auto& [kind, name, line, endLineOpt, fileScope, field]: tags) {
+        const auto pattern = escapePattern(parser.getLine(line));
+        for (size_t index = 0; index < kindsList.size(); ++index) {
+            if (!kindsList[index].contains(kind)) {
+                continue;
+            }
+            auto& chunk = result[index];
+            chunk.append(format("{}\t{}\t{};/^{}$/;\"\t{}\tline:{}", name, file, line, pattern, kind, line));
+            if (fileScope) {
+                chunk.append("\tfile:");
+            }
+            if (!field.empty()) {
+                chunk.append("\t").append(field);
+            }
+            if (endLineOpt.has_value()) {
+                chunk.append(format("\tend:{}", endLineOpt.value()));
+            }
+            chunk.push_back('\n');
+        }
+    }
+    return result;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <types/WorkStealingPool.h>
+
+namespace types {
+    class TagExtractor {
+    public:
+        struct Output {
+            std::string kinds;
+            std::filesystem::path path;
+        };
+
+        explicit TagExtractor(const WorkStealingPool& pool);
+
+        void extract(const std::vector<std::string>& files, const std::vector<Output>& outputs) const;
+
+        static std::vector<std::string> parse(
+            std::string_view content,
+            std::string_view file,
+            const std::vector<std::string_view>& kindsList
+        );
+
+    private:
+        const WorkStealingPool& _pool;
+    };
+}
@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <format>
+#include <ranges>
+#include <stdexcept>
+
+#include <types/TagIndex.h>
+#include <utils/common.h>
+#include <utils/iconv.h>
+
+using namespace std;
+using namespace types;
+using namespace utils;
+
+namespace {
+    vector<string_view> splitPath(const string_view path) {
+        vector<string_view> result;
+        for (const auto component: path | views::split('/')) {
+            if (!component.empty()) {
+                result.emplace_back(component.begin(), component.end());
+            }
+        }
+        return result;
+    }
+}
+
+TagIndex::TagIndex(const filesystem::path& path): _path(path), _mappedFile(in_place, path), _directoryNodes(1) {
+    const auto content = _mappedFile->content();
+    if (content.size() > UINT32_MAX) {
+        throw runtime_error(format("Tag file '{}' is too large to index", path.generic_string()));
+    }
+    unordered_map<string, uint32_t> fileIdMap;
+    size_t lineBegin = 0;
+    while (lineBegin < content.size()) {
+        auto lineEnd = content.find('\n', lineBegin);
+        if (lineEnd == string_view::npos) {
+            lineEnd = content.size();
+        }
+        if (const auto line = content.substr(lineBegin, lineEnd - lineBegin);
+            !line.empty() && !line.starts_with("!_")) {
+            const auto nameEnd = line.find('\t');
+            const auto fileEnd = line.find('\t', nameEnd + 1);
+            if (nameEnd != string_view::npos && fileEnd != string_view::npos) {
+                _entriesMap[common::hash(line.substr(0, nameEnd))].push_back({
+                    static_cast<uint32_t>(lineBegin),
+                    _internFile(line.substr(nameEnd + 1, fileEnd - nameEnd - 1), fileIdMap)
+                });
+                ++_entryCount;
+            }
+        }
+        lineBegin = lineEnd + 1;
+    }
+
+    uint32_t order = 0;
+    vector<pair<uint32_t, bool>> stack{{0, false}};
+    while (!stack.empty()) {
+        const auto [nodeIndex, isVisited] = stack.back();
+        stack.pop_back();
+        if (isVisited) {
+            _directoryNodes[nodeIndex].exit = order;
+            continue;
+        }
+        _directoryNodes[nodeIndex].enter = order++;
+        stack.emplace_back(nodeIndex, true);
+        for (const auto childIndex: _directoryNodes[nodeIndex].children | views::values) {
+            stack.emplace_back(childIndex, false);
+        }
+    }
+
+    _fileOrders.resize(_files.size());
+    for (uint32_t fileId = 0; fileId < _files.size(); ++fileId) {
+        uint32_t nodeIndex = 0;
+        for (const auto component: splitPath(_files[fileId])) {
+            nodeIndex = _directoryNodes[nodeIndex].children.at(string(component));
+        }
+        _fileOrders[fileId] = _directoryNodes[nodeIndex].enter;
+    }
+    for (auto& entries: _entriesMap | views::values) {
+        ranges::stable_sort(entries, {}, [this](const _Entry& entry) { return _fileOrders[entry.fileId]; });
+    }
+}
+
+vector<TagEntry> TagIndex::find(const string_view name) const {
+    vector<TagEntry> result;
+    const auto iterator = _entriesMap.find(common::hash(name));
+    if (iterator == _entriesMap.end()) {
+        return result;
+    }
+    result.reserve(iterator->second.size());
+    for (const auto& entry: iterator->second) {
+        if (const auto line = _getLine(entry.lineOffset);
+            line.substr(0, line.find('\t')) == name) {
+            result.emplace_back(line);
+        }
+    }
+    return result;
+}
+
+optional<TagEntry> TagIndex::findNearest(const string_view name, const filesystem::path& referencePath) const {
+    const auto iterator = _entriesMap.find(common::hash(name));
+    if (iterator == _entriesMap.end()) {
+        return nullopt;
+    }
+    const auto& entries = iterator->second;
+    const auto referencePathString = referencePath.generic_string();
+
+    vector<uint32_t> ancestors{0};
+    for (const auto component: splitPath(referencePathString)) {
+        const auto& children = _directoryNodes[ancestors.back()].children;
+        const auto childIterator = children.find(string(component));
+        if (childIterator == children.end()) {
+            break;
+        }
+        ancestors.push_back(childIterator->second);
+    }
+
+    for (const auto nodeIndex: ancestors | views::reverse) {
+        const auto& node = _directoryNodes[nodeIndex];
+        const auto orderOf = [this](const _Entry& entry) { return _fileOrders[entry.fileId]; };
+        const auto begin = ranges::lower_bound(entries, node.enter, {}, orderOf);
+        const auto end = ranges::lower_bound(begin, entries.end(), node.exit, {}, orderOf);
+
+        uint32_t mostCommonPathLength{};
+        optional<string_view> resultLine;
+        for (const auto& entry: ranges::subrange(begin, end)) {
+            const auto line = _getLine(entry.lineOffset);
+            if (line.substr(0, line.find('\t')) != name) {
+                continue;
+            }
+            if (const auto pathDistance = static_cast<uint32_t>(distance(
+                referencePathString.cbegin(), ranges::mismatch(referencePathString, _files[entry.fileId]).in1
+            )); pathDistance > mostCommonPathLength) {
+                mostCommonPathLength = pathDistance;
+                resultLine.emplace(line);
+            }
+        }
+        if (resultLine.has_value()) {
+            return TagEntry(resultLine.value());
+        }
+    }
+    return nullopt;
+}
+
+const filesystem::path& TagIndex::path() const {
+    return _path;
+}
+
+void TagIndex::relocate(const filesystem::path& path) {
+    const auto originalSize = _mappedFile->size();
+    _mappedFile.reset();
+    try {
+        filesystem::rename(_path, path);
+    } catch (...) {
+        _mappedFile.emplace(_path);
+        throw;
+    }
+    _path = path;
+    _mappedFile.emplace(_path);
+    if (_mappedFile->size() != originalSize) {
+        throw runtime_error(format("Tag file '{}' is modified during relocation", _path.generic_string()));
+    }
+}
+
+size_t TagIndex::size() const {
+    return _entryCount;
+}
+
+string_view TagIndex::_getLine(const uint32_t lineOffset) const {
+    auto line = _mappedFile->content().substr(lineOffset);
+    return line.substr(0, line.find('\n'));
+}
+
+uint32_t TagIndex::_internFile(const string_view file, unordered_map<string, uint32_t>& fileIdMap) {
+    const auto fileString = string(file);
+    if (const auto iterator = fileIdMap.find(fileString);
+        iterator != fileIdMap.end()) {
+        return iterator->second;
+    }
+    const auto fileId = static_cast<uint32_t>(_files.size());
+    auto normalizedFile = iconv::toPath(fileString).generic_string();
+    uint32_t nodeIndex = 0;
+    for (const auto component: splitPath(normalizedFile)) {
+        auto& children = _directoryNodes[nodeIndex].children;
+        if (const auto childIterator = children.find(string(component));
+            childIterator != children.end()) {
+            nodeIndex = childIterator->second;
+        } else {
+            const auto childIndex = static_cast<uint32_t>(_directoryNodes.size());
+            children.emplace(component, childIndex);
+            _directoryNodes.emplace_back();
+            nodeIndex = childIndex;
+        }
+    }
+    fileIdMap.emplace(fileString, fileId);
+    _files.push_back(move(normalizedFile));
+    return fileId;
+}
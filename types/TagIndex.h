@@ -0,0 +1,51 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include <types/MappedFile.h>
+#include <types/TagEntry.h>
+
+namespace types {
+    class TagIndex {
+    public:
+        explicit TagIndex(const std::filesystem::path& path);
+
+        [[nodiscard]] std::vector<TagEntry> find(std::string_view name) const;
+
+        [[nodiscard]] std::optional<TagEntry> findNearest(
+            std::string_view name,
+            const std::filesystem::path& referencePath
+        ) const;
+
+        [[nodiscard]] const std::filesystem::path& path() const;
+
+        void relocate(const std::filesystem::path& path);
+
+        [[nodiscard]] size_t size() const;
+
+    private:
+        struct _DirectoryNode {
+            std::unordered_map<std::string, uint32_t> children;
+            uint32_t enter{}, exit{};
+        };
+
+        struct _Entry {
+            uint32_t lineOffset, fileId;
+        };
+
+        std::filesystem::path _path;
+        std::optional<MappedFile> _mappedFile;
+        std::unordered_map<uint64_t, std::vector<_Entry>> _entriesMap;
+        std::vector<_DirectoryNode> _directoryNodes;
+        std::vector<std::string> _files;
+        std::vector<uint32_t> _fileOrders;
+        size_t _entryCount{};
+
+        [[nodiscard]] std::string_view _getLine(uint32_t lineOffset) const;
+
+        uint32_t _internFile(std::string_view file, std::unordered_map<std::string, uint32_t>& fileIdMap);
+    };
+}
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <ranges>
+
+#include <types/TagManifest.h>
+#include <utils/logger.h>
+
+using namespace std;
+using namespace types;
+using namespace utils;
+
+namespace {
+    const unordered_set<string> sourceExtensions{
+        ".c", ".cc", ".cpp", ".cxx", ".h", ".hh", ".hpp", ".hxx", ".inl",
+    };
+}
+
+bool TagManifest::Difference::empty() const {
+    return changedFiles.empty() && removedFiles.empty();
+}
+
+TagManifest::TagManifest(const filesystem::path& rootPath): _rootPath(rootPath) {
+    _scan(rootPath);
+}
+
+TagManifest::Difference TagManifest::compare(const TagManifest& previous) const {
+    Difference difference;
+    for (const auto& [file, fileStamp]: _fileStamps) {
+        if (const auto iterator = previous._fileStamps.find(file);
+            iterator == previous._fileStamps.end() || iterator->second != fileStamp) {
+            difference.changedFiles.emplace(file);
+        }
+    }
+    for (const auto& file: previous._fileStamps | views::keys) {
+        if (!_fileStamps.contains(file)) {
+            difference.removedFiles.emplace(file);
+        }
+    }
+    return difference;
+}
+
+vector<string> TagManifest::files() const {
+    vector<string> result;
+    result.reserve(_fileStamps.size());
+    ranges::copy(_fileStamps | views::keys, back_inserter(result));
+    return result;
+}
+
+const filesystem::path& TagManifest::rootPath() const {
+    return _rootPath;
+}
+
+void TagManifest::save(const filesystem::path& manifestPath) const {
+    auto stream = ofstream{manifestPath, ios::trunc};
+    stream.exceptions(ios_base::badbit | ios_base::failbit);
+    stream << _rootPath.generic_string() << '\n';
+    for (const auto& [file, fileStamp]: _fileStamps) {
+        stream << fileStamp.first << '\t' << fileStamp.second << '\t' << file << '\n';
+    }
+}
+
+optional<TagManifest> TagManifest::load(const filesystem::path& manifestPath) {
+    auto stream = ifstream{manifestPath};
+    if (!stream) {
+        return nullopt;
+    }
+    TagManifest result;
+    string line;
+    if (!getline(stream, line)) {
+        return nullopt;
+    }
+    result._rootPath = line;
+    while (getline(stream, line)) {
+        const auto firstTab = line.find('\t');
+        const auto secondTab = line.find('\t', firstTab + 1);
+        if (firstTab == string::npos || secondTab == string::npos) {
+            return nullopt;
+        }
+        try {
+            result._fileStamps.emplace(
+                line.substr(secondTab + 1),
+                FileStamp{stoull(line.substr(0, firstTab)), stoll(line.substr(firstTab + 1, secondTab - firstTab - 1))}
+            );
+        } catch (...) {
+            return nullopt;
+        }
+    }
+    return result;
+}
+
+TagManifest TagManifest::update(const unordered_set<string>& files) const {
+    auto result = *this;
+    for (const auto& file: files) {
+        const auto normalizedFile = normalize(file);
+        const auto path = filesystem::path(file);
+        error_code errorCode;
+        if (filesystem::is_directory(path, errorCode)) {
+            result._eraseDirectory(normalizedFile);
+            result._scan(path);
+            continue;
+        }
+        if (const auto fileSize = filesystem::file_size(path, errorCode); !errorCode && isSourceFile(path)) {
+            if (const auto lastWriteTime = filesystem::last_write_time(path, errorCode); !errorCode) {
+                result._fileStamps.insert_or_assign(
+                    normalizedFile, FileStamp{fileSize, lastWriteTime.time_since_epoch().count()}
+                );
+                continue;
+            }
+        }
+        result._fileStamps.erase(normalizedFile);
+        if (!filesystem::exists(path, errorCode)) {
+            result._eraseDirectory(normalizedFile);
+        }
+    }
+    return result;
+}
+
+bool TagManifest::isSourceFile(const filesystem::path& path) {
+    auto extension = path.extension().string();
+    ranges::transform(extension, extension.begin(), [](const char character) {
+        return static_cast<char>(tolower(static_cast<unsigned char>(character)));
+    });
+    return sourceExtensions.contains(extension);
+}
+
+string TagManifest::normalize(const string_view file) {
+    string result{file};
+    ranges::replace(result, '\\', '/');
+    return result;
+}
+
+void TagManifest::_eraseDirectory(const string& directory) {
+    const auto directoryPrefix = directory.ends_with('/') ? directory : directory + '/';
+    erase_if(_fileStamps, [&directoryPrefix](const auto& item) {
+        return item.first.starts_with(directoryPrefix);
+    });
+}
+
+void TagManifest::_scan(const filesystem::path& directory) {
+    const filesystem::recursive_directory_iterator end;
+    error_code errorCode;
+    auto iterator = filesystem::recursive_directory_iterator(
+        directory, filesystem::directory_options::skip_permission_denied, errorCode
+    );
+    while (!errorCode && iterator != end) {
+        if (iterator->is_regular_file(errorCode) && isSourceFile(iterator->path())) {
+            if (const auto fileSize = iterator->file_size(errorCode); !errorCode) {
+                if (const auto lastWriteTime = iterator->last_write_time(errorCode); !errorCode) {
+                    _fileStamps.insert_or_assign(
+                        normalize(iterator->path().generic_string()),
+                        FileStamp{fileSize, lastWriteTime.time_since_epoch().count()}
+                    );
+                }
+            }
+        }
+        if (errorCode) {
+            logger::debug(format(
+                "Skip '{}' when scanning: {}", iterator->path().generic_string(), errorCode.message()
+            ));
+            errorCode.clear();
+        }
+        iterator.increment(errorCode);
+        if (errorCode && iterator != end) {
+            logger::warn(format(
+                "Skip directory '{}' when scanning: {}", iterator->path().generic_string(), errorCode.message()
+            ));
+            errorCode.clear();
+            iterator.disable_recursion_pending();
+            iterator.increment(errorCode);
+        }
+    }
+    if (errorCode) {
+        logger::warn(format("Stop scanning '{}': {}", directory.generic_string(), errorCode.message()));
+    }
+}
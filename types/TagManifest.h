@@ -0,0 +1,50 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace types {
+    class TagManifest {
+    public:
+        struct Difference {
+            std::unordered_set<std::string> changedFiles, removedFiles;
+
+            [[nodiscard]] bool empty() const;
+        };
+
+        explicit TagManifest(const std::filesystem::path& rootPath);
+
+        [[nodiscard]] Difference compare(const TagManifest& previous) const;
+
+        [[nodiscard]] std::vector<std::string> files() const;
+
+        [[nodiscard]] const std::filesystem::path& rootPath() const;
+
+        void save(const std::filesystem::path& manifestPath) const;
+
+        [[nodiscard]] TagManifest update(const std::unordered_set<std::string>& files) const;
+
+        static bool isSourceFile(const std::filesystem::path& path);
+
+        static std::optional<TagManifest> load(const std::filesystem::path& manifestPath);
+
+        static std::string normalize(std::string_view file);
+
+    private:
+        using FileStamp = std::pair<uintmax_t, int64_t>;
+
+        std::filesystem::path _rootPath;
+        std::unordered_map<std::string, FileStamp> _fileStamps;
+
+        TagManifest() = default;
+
+        void _eraseDirectory(const std::string& directory);
+
+        void _scan(const std::filesystem::path& directory);
+    };
+}
@@ -0,0 +1,95 @@
+#include <limits>
+
+#include <types/TriggerRules.h>
+
+using namespace std;
+using namespace types;
+
+namespace {
+    constexpr auto wordClasses = [] {
+        array<uint8_t, 256> result{};
+        uint8_t wordClass = 1;
+        for (auto character = '0'; character <= '9'; ++character) {
+            result[static_cast<unsigned char>(character)] = wordClass++;
+        }
+        for (auto character = 'A'; character <= 'Z'; ++character) {
+            result[static_cast<unsigned char>(character)] = wordClass++;
+        }
+        for (auto character = 'a'; character <= 'z'; ++character) {
+            result[static_cast<unsigned char>(character)] = wordClass++;
+        }
+        result['_'] = wordClass;
+        return result;
+    }();
+}
+
+TriggerRules::TriggerRules()
+    : TriggerRules({"class", "if", "for", "struct", "switch", "union", "while"}, "{}", ";") {}
+
+TriggerRules::TriggerRules(
+    const vector<string>& keywords,
+    const string_view ignoredCharacters,
+    const string_view keywordCharacters
+) {
+    _transitions.emplace_back();
+    _terminals.push_back(0);
+    for (const auto& keyword: keywords) {
+        _addKeyword(keyword);
+    }
+    for (const auto character: ignoredCharacters) {
+        _actions[static_cast<unsigned char>(character)] = Action::Ignore;
+    }
+    for (const auto character: keywordCharacters) {
+        _actions[static_cast<unsigned char>(character)] = Action::RequireKeyword;
+    }
+}
+
+TriggerRules::Action TriggerRules::action(const char character) const {
+    return _actions[static_cast<unsigned char>(character)];
+}
+
+bool TriggerRules::containsKeyword(const string_view line) const {
+    uint16_t state = 0;
+    bool isInWord = false;
+    for (const auto character: line) {
+        if (const auto wordClass = wordClasses[static_cast<unsigned char>(character)]; wordClass) {
+            if (!isInWord) {
+                isInWord = true;
+                state = _transitions[0][wordClass];
+            } else if (state) {
+                state = _transitions[state][wordClass];
+            }
+        } else {
+            if (isInWord && _terminals[state]) {
+                return true;
+            }
+            isInWord = false;
+        }
+    }
+    return isInWord && _terminals[state];
+}
+
+const vector<string>& TriggerRules::keywords() const {
+    return _keywords;
+}
+
+void TriggerRules::_addKeyword(const string_view keyword) {
+    if (keyword.empty()) {
+        return;
+    }
+    uint16_t state = 0;
+    for (const auto character: keyword) {
+        const auto wordClass = wordClasses[static_cast<unsigned char>(character)];
+        if (!wordClass || _transitions.size() >= numeric_limits<uint16_t>::max()) {
+            return;
+        }
+        if (!_transitions[state][wordClass]) {
+            _transitions[state][wordClass] = static_cast<uint16_t>(_transitions.size());
+            _transitions.emplace_back();
+            _terminals.push_back(0);
+        }
+        state = _transitions[state][wordClass];
+    }
+    _terminals[state] = 1;
+    _keywords.emplace_back(keyword);
+}
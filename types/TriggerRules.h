@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace types {
+    class TriggerRules {
+    public:
+        enum class Action : uint8_t {
+            Trigger,
+            Ignore,
+            RequireKeyword,
+        };
+
+        TriggerRules();
+
+        TriggerRules(
+            const std::vector<std::string>& keywords,
+            std::string_view ignoredCharacters,
+            std::string_view keywordCharacters
+        );
+
+        [[nodiscard]] Action action(char character) const;
+
+        [[nodiscard]] bool containsKeyword(std::string_view line) const;
+
+        [[nodiscard]] const std::vector<std::string>& keywords() const;
+
+    private:
+        static constexpr uint8_t _wordClassCount = 64;
+
+        std::array<Action, 256> _actions{};
+        std::vector<std::array<uint16_t, _wordClassCount>> _transitions;
+        std::vector<uint8_t> _terminals;
+        std::vector<std::string> _keywords;
+
+        void _addKeyword(std::string_view keyword);
+    };
+}
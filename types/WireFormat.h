@@ -0,0 +1,9 @@
+#pragma once
+
+namespace types {
+    enum class WireFormat {
+        Cbor,
+        Json,
+        MsgPack,
+    };
+}
@@ -0,0 +1,135 @@
+#include <format>
+#include <thread>
+
+#include <types/WorkStealingPool.h>
+#include <utils/logger.h>
+
+using namespace std;
+using namespace types;
+using namespace utils;
+
+namespace {
+    thread_local const void* currentPool = nullptr;
+    thread_local size_t currentWorkerIndex = 0;
+}
+
+WorkStealingPool::TaskGroup::TaskGroup(const WorkStealingPool& pool): _pool(pool), _state(make_shared<_State>()) {}
+
+WorkStealingPool::TaskGroup::~TaskGroup() {
+    wait();
+}
+
+void WorkStealingPool::TaskGroup::cancel() const {
+    _state->cancelled.store(true);
+}
+
+bool WorkStealingPool::TaskGroup::cancelled() const {
+    return _state->cancelled.load();
+}
+
+void WorkStealingPool::TaskGroup::submit(Task&& task) const {
+    ++_state->pendingCount;
+    _pool.submit([state = _state, task = move(task)] {
+        if (!state->cancelled.load()) {
+            try {
+                task();
+            } catch (const exception& e) {
+                logger::warn(format("(WorkStealingPool) Exception: {}", e.what()));
+            } catch (...) {
+                logger::warn("(WorkStealingPool) Unknown exception");
+            }
+        }
+        if (--state->pendingCount == 0) {
+            unique_lock lock(state->mutex);
+            state->condition.notify_all();
+        }
+    });
+}
+
+void WorkStealingPool::TaskGroup::wait() const {
+    const auto preferredIndex = currentPool == _pool._state.get() ? currentWorkerIndex : 0;
+    while (_state->pendingCount.load()) {
+        if (_pool._state->runOne(preferredIndex)) {
+            continue;
+        }
+        unique_lock lock(_state->mutex);
+        _state->condition.wait_for(lock, 1ms, [this] { return !_state->pendingCount.load(); });
+    }
+}
+
+WorkStealingPool::WorkStealingPool(const uint32_t threadCount): _state(make_shared<_State>()) {
+    const auto workerCount = max(threadCount, 1u);
+    _state->workers.reserve(workerCount);
+    for (uint32_t index = 0; index < workerCount; ++index) {
+        _state->workers.push_back(make_unique<_Worker>());
+    }
+    for (uint32_t index = 0; index < workerCount; ++index) {
+        thread([state = _state, index] {
+            currentPool = state.get();
+            currentWorkerIndex = index;
+            while (state->isRunning.load()) {
+                if (state->runOne(index)) {
+                    continue;
+                }
+                unique_lock lock(state->mutex);
+                state->condition.wait(lock, [&state] {
+                    return !state->isRunning.load() || state->queuedCount.load();
+                });
+            }
+        }).detach();
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    _state->isRunning.store(false);
+    unique_lock lock(_state->mutex);
+    _state->condition.notify_all();
+}
+
+void WorkStealingPool::submit(Task&& task) const {
+    const auto workerIndex = currentPool == _state.get()
+                                 ? currentWorkerIndex
+                                 : _state->nextWorker++ % _state->workers.size(); {
+        const auto& worker = _state->workers[workerIndex];
+        unique_lock lock(worker->mutex);
+        worker->tasks.push_back(move(task));
+    }
+    ++_state->queuedCount;
+    unique_lock lock(_state->mutex);
+    _state->condition.notify_one();
+}
+
+uint32_t WorkStealingPool::threadCount() const {
+    return static_cast<uint32_t>(_state->workers.size());
+}
+
+bool WorkStealingPool::_State::runOne(const size_t preferredIndex) {
+    Task task; {
+        const auto& worker = workers[preferredIndex];
+        unique_lock lock(worker->mutex);
+        if (!worker->tasks.empty()) {
+            task = move(worker->tasks.back());
+            worker->tasks.pop_back();
+        }
+    }
+    for (size_t offset = 1; !task && offset < workers.size(); ++offset) {
+        const auto& victim = workers[(preferredIndex + offset) % workers.size()];
+        unique_lock lock(victim->mutex);
+        if (!victim->tasks.empty()) {
+            task = move(victim->tasks.front());
+            victim->tasks.pop_front();
+        }
+    }
+    if (!task) {
+        return false;
+    }
+    --queuedCount;
+    try {
+        task();
+    } catch (const exception& e) {
+        logger::warn(format("(WorkStealingPool) Exception: {}", e.what()));
+    } catch (...) {
+        logger::warn("(WorkStealingPool) Unknown exception");
+    }
+    return true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace types {
+    class WorkStealingPool {
+    public:
+        using Task = std::function<void()>;
+
+        class TaskGroup {
+        public:
+            explicit TaskGroup(const WorkStealingPool& pool);
+
+            ~TaskGroup();
+
+            void cancel() const;
+
+            [[nodiscard]] bool cancelled() const;
+
+            void submit(Task&& task) const;
+
+            void wait() const;
+
+        private:
+            struct _State {
+                std::atomic<bool> cancelled{false};
+                std::atomic<uint32_t> pendingCount{0};
+                std::mutex mutex;
+                std::condition_variable condition;
+            };
+
+            const WorkStealingPool& _pool;
+            std::shared_ptr<_State> _state;
+        };
+
+        explicit WorkStealingPool(uint32_t threadCount);
+
+        ~WorkStealingPool();
+
+        void submit(Task&& task) const;
+
+        [[nodiscard]] uint32_t threadCount() const;
+
+    private:
+        struct _Worker {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        struct _State {
+            std::atomic<bool> isRunning{true};
+            std::atomic<uint32_t> nextWorker{0}, queuedCount{0};
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::vector<std::unique_ptr<_Worker>> workers;
+
+            bool runOne(size_t preferredIndex);
+        };
+
+        std::shared_ptr<_State> _state;
+    };
+}
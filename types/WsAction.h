@@ -8,6 +8,7 @@ namespace types {
         CompletionCancel,
         CompletionEdit,
         CompletionGenerate,
+        CompletionReuse,
         CompletionSelect,
         EditorCommit,
         EditorConfig,
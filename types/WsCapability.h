@@ -0,0 +1,10 @@
+#pragma once
+
+namespace types {
+    enum class WsCapability {
+        BatchCacheAck,
+        CompletionReuse,
+        Compression,
+        DeltaContext,
+    };
+}
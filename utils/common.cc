@@ -1,3 +1,8 @@
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+
 #include <components/ConfigManager.h>
 #include <components/InteractionMonitor.h>
 #include <components/MemoryManipulator.h>
@@ -54,6 +59,23 @@ uint32_t common::countLines(const std::string& content) {
     return content.empty() ? 0 : ranges::count(content, '\n') + 1;
 }
 
+uint32_t common::estimateTokens(const std::string_view content) {
+    uint32_t result{}, wordLength{};
+    for (const auto character: content) {
+        const auto byte = static_cast<unsigned char>(character);
+        if (byte >= 0x80 || isalnum(byte) || byte == '_') {
+            ++wordLength;
+            continue;
+        }
+        result += (wordLength + 3) / 4;
+        wordLength = 0;
+        if (!isspace(byte) || byte == '\n') {
+            ++result;
+        }
+    }
+    return result + (wordLength + 3) / 4;
+}
+
 CaretDimension common::getCaretDimensions(const bool waitTillAvailable) {
     const auto [clientX, clientY] = WindowManager::GetInstance()->getClientPosition();
 
@@ -77,6 +99,15 @@ CaretDimension common::getCaretDimensions(const bool waitTillAvailable) {
     };
 }
 
+uint64_t common::hash(const std::string_view data, const uint64_t seed) {
+    auto result = seed;
+    for (const auto character: data) {
+        result ^= static_cast<uint8_t>(character);
+        result *= 0x100000001b3;
+    }
+    return result;
+}
+
 void common::insertContent(const std::string& content) { {
         const auto memoryManipulator = MemoryManipulator::GetInstance();
         const auto currentPosition = memoryManipulator->getCaretPosition();
@@ -163,19 +194,29 @@ uint32_t common::toKeycode(const char key, const ModifierSet& modifiers) {
 }
 
 string common::uuid() {
-    GUID gidReference;
-    HRESULT result;
-    do {
-        result = CoCreateGuid(&gidReference);
-        if (result != S_OK) {
-            std::this_thread::sleep_for(1ms);
+    static const auto processSeed = [] {
+        GUID gidReference;
+        while (CoCreateGuid(&gidReference) != S_OK) {
+            this_thread::sleep_for(1ms);
         }
-    } while (result != S_OK);
-    return format(
-        "{:08x}-{:04x}-{:04x}-{:02x}{:02x}-{:02x}{:02x}{:02x}{:02x}{:02x}{:02x}",
-        gidReference.Data1, gidReference.Data2, gidReference.Data3,
-        gidReference.Data4[0], gidReference.Data4[1],
-        gidReference.Data4[2], gidReference.Data4[3], gidReference.Data4[4],
-        gidReference.Data4[5], gidReference.Data4[6], gidReference.Data4[7]
-    );
+        array<uint64_t, 2> seed{};
+        memcpy(seed.data(), &gidReference, sizeof(seed));
+        return seed;
+    }();
+    static atomic<uint64_t> sequence{0};
+
+    const auto high = processSeed[0];
+    const auto low = processSeed[1] ^ sequence.fetch_add(1, memory_order_relaxed) * 0x9e3779b97f4a7c15;
+    string result(36, '-');
+    const auto writeHex = [&result](const size_t position, uint64_t value, const size_t digitCount) {
+        for (auto index = position + digitCount; index > position; value >>= 4) {
+            result[--index] = "0123456789abcdef"[value & 0xF];
+        }
+    };
+    writeHex(0, high >> 32, 8);
+    writeHex(9, high >> 16, 4);
+    writeHex(14, high, 4);
+    writeHex(19, low >> 48, 4);
+    writeHex(24, low, 12);
+    return result;
 }
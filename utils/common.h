@@ -9,8 +9,12 @@ namespace utils::common {
 
     uint32_t countLines(const std::string& content);
 
+    uint32_t estimateTokens(std::string_view content);
+
     types::CaretDimension getCaretDimensions(bool waitTillAvailable = true);
 
+    uint64_t hash(std::string_view data, uint64_t seed = 0xcbf29ce484222325);
+
     void insertContent(const std::string& content);
 
     void replaceContent(const types::Selection& replaceRange, std::string content);
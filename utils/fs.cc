@@ -1,12 +1,119 @@
+#include <bit>
 #include <filesystem>
 #include <fstream>
-#include <regex>
+#include <memory>
+#include <mutex>
+#include <vector>
 
+#include <types/LruCache.h>
 #include <utils/fs.h>
 
+#include <emmintrin.h>
+
 using namespace std;
+using namespace types;
 using namespace utils;
 
+namespace {
+    class CachedFile {
+    public:
+        CachedFile(const filesystem::path& path, const filesystem::file_time_type lastWriteTime, const uintmax_t size)
+            : _lastWriteTime(lastWriteTime), _size(size) {
+            auto stream = ifstream{path, ios::binary};
+            stream.exceptions(ios_base::badbit);
+            _content.resize(size);
+            stream.read(_content.data(), static_cast<streamsize>(size));
+            _content.resize(stream.gcount());
+        }
+
+        [[nodiscard]] bool isStale(const filesystem::file_time_type lastWriteTime, const uintmax_t size) const {
+            return lastWriteTime != _lastWriteTime || size != _size;
+        }
+
+        [[nodiscard]] string getLines(const uint32_t startLine, const uint32_t endLine) const {
+            call_once(_lineOffsetsFlag, [this] { _buildLineOffsets(); });
+            auto lineCount = _lineOffsets.size();
+            if (_lineOffsets.back() == _content.size()) {
+                --lineCount;
+            }
+            if (startLine >= lineCount) {
+                return {};
+            }
+            const auto rangeEnd = min<size_t>(static_cast<size_t>(endLine) + 1, lineCount);
+            const auto begin = _lineOffsets[startLine];
+            const auto end = rangeEnd < _lineOffsets.size() ? _lineOffsets[rangeEnd] : _content.size();
+
+            string out;
+            out.reserve(end - begin + 1);
+            for (auto index = begin; index < end; ++index) {
+                if (_content[index] != '\r') {
+                    out.push_back(_content[index]);
+                }
+            }
+            if (_content[end - 1] != '\n') {
+                out.push_back('\n');
+            }
+            return out;
+        }
+
+    private:
+        filesystem::file_time_type _lastWriteTime;
+        uintmax_t _size;
+        string _content;
+        mutable once_flag _lineOffsetsFlag;
+        mutable vector<size_t> _lineOffsets;
+
+        void _buildLineOffsets() const {
+            _lineOffsets.push_back(0);
+            const auto data = _content.data();
+            const auto size = _content.size();
+            const auto newlines = _mm_set1_epi8('\n');
+            size_t offset = 0;
+            for (; offset + 16 <= size; offset += 16) {
+                auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + offset)), newlines
+                )));
+                while (mask) {
+                    _lineOffsets.push_back(offset + countr_zero(mask) + 1);
+                    mask &= mask - 1;
+                }
+            }
+            for (; offset < size; ++offset) {
+                if (data[offset] == '\n') {
+                    _lineOffsets.push_back(offset + 1);
+                }
+            }
+        }
+    };
+
+    mutex cachedFilesMutex;
+    LruCache<string, shared_ptr<const CachedFile>> cachedFiles{64};
+
+    shared_ptr<const CachedFile> getCachedFile(const string& path) {
+        const auto filePath = filesystem::path(path);
+        error_code errorCode;
+        const auto lastWriteTime = filesystem::last_write_time(filePath, errorCode);
+        if (errorCode) {
+            return nullptr;
+        }
+        const auto size = filesystem::file_size(filePath, errorCode);
+        if (errorCode) {
+            return nullptr;
+        } {
+            unique_lock lock{cachedFilesMutex};
+            if (const auto cachedFileOpt = cachedFiles.get(path);
+                cachedFileOpt.has_value() && !cachedFileOpt.value()->isStale(lastWriteTime, size)) {
+                return cachedFileOpt.value();
+            }
+        }
+        auto cachedFile = make_shared<const CachedFile>(filePath, lastWriteTime, size); {
+            unique_lock lock{cachedFilesMutex};
+            cachedFiles.put(path, cachedFile);
+        }
+        return cachedFile;
+    }
+}
+
 string fs::readFile(const string& path) {
     if (path.empty()) {
         return {};
@@ -29,22 +136,8 @@ string fs::readFile(const string& path, const uint32_t startLine, const uint32_t
     if (path.empty() || startLine > endLine) {
         return {};
     }
-    auto stream = ifstream{path.data()};
-    stream.exceptions(ios_base::badbit);
-
-    string line, out;
-    uint32_t count{};
-
-    while (getline(stream, line)) {
-        ++count;
-        if (count <= startLine) {
-            continue;
-        }
-        if (count > endLine + 1) {
-            break;
-        }
-        out.append(line).append("\n");
+    if (const auto cachedFile = getCachedFile(path)) {
+        return cachedFile->getLines(startLine, endLine);
     }
-    erase(out, '\r');
-    return out;
+    return {};
 }
@@ -0,0 +1,59 @@
+#include <format>
+#include <stdexcept>
+
+#include <zlib.h>
+
+#include <utils/zlib.h>
+
+using namespace std;
+using namespace utils;
+
+string zlib::compress(const string_view source, const int level) {
+    auto destinationLength = compressBound(static_cast<uLong>(source.size()));
+    string destination(destinationLength, '\0');
+    if (const auto result = compress2(
+        reinterpret_cast<Bytef*>(destination.data()),
+        &destinationLength,
+        reinterpret_cast<const Bytef*>(source.data()),
+        static_cast<uLong>(source.size()),
+        level
+    ); result != Z_OK) {
+        throw runtime_error(format("Failed to compress {} bytes (Code: {})", source.size(), result));
+    }
+    destination.resize(destinationLength);
+    return destination;
+}
+
+string zlib::decompress(const string_view source) {
+    z_stream stream{};
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(source.data()));
+    stream.avail_in = static_cast<uInt>(source.size());
+    if (const auto result = inflateInit(&stream); result != Z_OK) {
+        throw runtime_error(format("Failed to initialize inflate (Code: {})", result));
+    }
+
+    string destination;
+    char buffer[16384];
+    int result;
+    do {
+        stream.next_out = reinterpret_cast<Bytef*>(buffer);
+        stream.avail_out = sizeof(buffer);
+        result = inflate(&stream, Z_NO_FLUSH);
+        if (result != Z_OK && result != Z_STREAM_END) {
+            inflateEnd(&stream);
+            throw runtime_error(format("Failed to decompress {} bytes (Code: {})", source.size(), result));
+        }
+        destination.append(buffer, sizeof(buffer) - stream.avail_out);
+    } while (result != Z_STREAM_END && (stream.avail_in || !stream.avail_out));
+    inflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        throw runtime_error(format("Truncated compressed data ({} bytes)", source.size()));
+    }
+    return destination;
+}
+
+bool zlib::isCompressed(const string_view source) {
+    return source.size() >= 2 &&
+           static_cast<unsigned char>(source[0]) == 0x78 &&
+           (static_cast<unsigned char>(source[0]) << 8 | static_cast<unsigned char>(source[1])) % 31 == 0;
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace utils::zlib {
+    std::string compress(std::string_view source, int level);
+
+    std::string decompress(std::string_view source);
+
+    bool isCompressed(std::string_view source);
+}